@@ -4,3 +4,6 @@
 
 #include "CoreMinimal.h"
 
+// Журнал модуля: ошибки и итоги, которые должны попасть в лог и без экрана (-nullrhi, Test, Shipping)
+MEL_API DECLARE_LOG_CATEGORY_EXTERN(LogMel, Log, All);
+
@@ -1,129 +1,162 @@
 #include "AAActor.h"
-#include "RadarActor.h"
+#include "RadarNetworkSubsystem.h"
 #include "MissleActor.h"
 #include "AAProjectileActor.h"
-#include "Kismet/GameplayStatics.h"
+#include "MissileMovementSubsystem.h"
+#include "MelActorPoolSubsystem.h"
+#include "EngagementClockSubsystem.h"
+#include "FireControlSubsystem.h"
+#include "MelDebug.h"
+#include "MelStats.h"
+#include "MelSimBridge.h"
 #include "Engine/World.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/Engine.h"
 
 AAAActor::AAAActor()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Перезарядка - время готовности, выстрелы назначает подсистема управления огнем
+    PrimaryActorTick.bCanEverTick = false;
     Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
     RootComponent = Mesh;
-    RadarRef = nullptr;
-    TimeSinceLastFire = 0.0f;
+    RadarNetwork = nullptr;
+    MovementSystem = nullptr;
+    ActorPool = nullptr;
+    EngagementClock = nullptr;
+    FireControl = nullptr;
+    ReadyTime = 0.0f;
 }
 
 void AAAActor::BeginPlay()
 {
     Super::BeginPlay();
-    TimeSinceLastFire = 0.0f;
-    
-    // Автоматически найти радар, если не установлен
-    if (!RadarRef)
+    ReadyTime = UEngagementClockSubsystem::GetEngagementTime(GetWorld()) + FireInterval;
+    MovementSystem = GetWorld()->GetSubsystem<UMissileMovementSubsystem>();
+
+    ActorPool = GetWorld()->GetSubsystem<UMelActorPoolSubsystem>();
+    if (ActorPool && ProjectileClass)
     {
-        TArray<AActor*> FoundRadars;
-        UGameplayStatics::GetAllActorsOfClass(GetWorld(), ARadarActor::StaticClass(), FoundRadars);
-        if (FoundRadars.Num() > 0)
-        {
-            RadarRef = Cast<ARadarActor>(FoundRadars[0]);
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, TEXT("ПВО: Автоматически найден радар"));
-        }
-        else
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("ПВО: Радар не найден на уровне!"));
-        }
+        ActorPool->Prewarm(ProjectileClass, ProjectilePoolSize);
+    }
+
+    EngagementClock = GetWorld()->GetSubsystem<UEngagementClockSubsystem>();
+    if (EngagementClock)
+    {
+        EngagementClock->RecordBattery(GetActorLocation());
+    }
+
+    FireControl = GetWorld()->GetSubsystem<UFireControlSubsystem>();
+    if (FireControl)
+    {
+        FireControl->RegisterBattery(this);
     }
+
+    // Цели дает вся сеть радаров, а не один радар; радары регистрируются в сети в своем BeginPlay
+    RadarNetwork = GetWorld()->GetSubsystem<URadarNetworkSubsystem>();
 }
 
-void AAAActor::Tick(float DeltaTime)
+void AAAActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaTime);
-    TimeSinceLastFire += DeltaTime;
-    TryFireAtMissile();
+    if (FireControl)
+    {
+        FireControl->UnregisterBattery(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
-void AAAActor::SetRadar(ARadarActor* Radar)
+void AAAActor::SetProjectileClass(TSubclassOf<AAAProjectileActor> InProjectileClass)
 {
-    RadarRef = Radar;
+    ProjectileClass = InProjectileClass;
 }
 
-AMissleActor* AAAActor::FindTargetMissile()
+bool AAAActor::IsReadyToFire() const
 {
-    if (!RadarRef) 
+    const float Now = UEngagementClockSubsystem::GetEngagementTime(GetWorld());
+    if (Now < ReadyTime) 
     {
-        GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Red, TEXT("ПВО: Нет ссылки на радар!"));
-        return nullptr;
+        MEL_DEBUG(Verbose, this, 0.5f, FColor::Blue, TEXT("ПВО: Ожидание %.1f сек"), ReadyTime - Now);
+        return false;
     }
-    
-    // Получаем только ракеты, обнаруженные 3 раза
-    TArray<AMissleActor*> ValidMissiles = RadarRef->GetMissilesDetectedThreeTimes();
-    if (ValidMissiles.Num() == 0) 
+
+    if (!RadarNetwork || RadarNetwork->GetRadars().Num() == 0) 
     {
-        GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Yellow, TEXT("ПВО: Нет ракет, обнаруженных 3 раза"));
-        return nullptr;
+        MEL_DEBUG(Error, this, 1.0f, FColor::Red, TEXT("ПВО: В сети нет радаров!"));
+        return false;
     }
     
-    GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Green, FString::Printf(TEXT("ПВО: Найдено %d ракет для стрельбы"), ValidMissiles.Num()));
-    
-    // Выбираем ближайшую ракету из тех, что обнаружены 3 раза
-    float MinDist = FLT_MAX;
-    AMissleActor* Closest = nullptr;
-    for (AMissleActor* Missile : ValidMissiles)
+    if (!ProjectileClass) 
     {
-        if (Missile && Missile->IsValidLowLevel())
-        {
-            float Dist = FVector::Dist(Missile->GetActorLocation(), GetActorLocation());
-            if (Dist < MinDist)
-            {
-                MinDist = Dist;
-                Closest = Missile;
-            }
-        }
+        MEL_DEBUG(Error, this, 2.0f, FColor::Red, TEXT("ПВО: Не указан класс снаряда!"));
+        return false;
     }
-    return Closest;
+    return true;
 }
 
-void AAAActor::TryFireAtMissile()
+bool AAAActor::IsInRange(const FVector& Location) const
 {
-    if (TimeSinceLastFire < FireInterval) 
+    return FVector::DistSquared(Location, GetActorLocation()) < FMath::Square(DetectionRadius);
+}
+
+bool AAAActor::SolveFireControl(const FRadarFusedTrack& Target, MelSim::FInterceptSolution& OutIntercept) const
+{
+    const MelSim::FVec3 Shooter = MelSim::ToSim(GetActorLocation());
+    const MelSim::FVec3 TrackPosition = MelSim::ToSim(Target.Position);
+    const MelSim::FVec3 TrackVelocity = MelSim::ToSim(Target.Velocity);
+
+    // От движения ракеты берется только профиль фаз, положение и скорость - оценка трека
+    MelSim::FMissileState MissileState;
+    MelSim::FMissileParams MissileParams;
+    if (MovementSystem && MovementSystem->GetMissileState(Target.Missile->GetMovementId(), MissileState, MissileParams))
     {
-        GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Blue, FString::Printf(TEXT("ПВО: Ожидание %.1f сек"), FireInterval - TimeSinceLastFire));
-        return;
+        MissileState.Position = TrackPosition;
+        MissileState.Velocity = TrackVelocity;
+        return MelSim::SolveMissileIntercept(Shooter, ProjectileSpeed, MissileState, MissileParams, MaxInterceptTime, OutIntercept);
     }
-    
-    AMissleActor* TargetMissile = FindTargetMissile();
-    if (!TargetMissile) 
+
+    return MelSim::SolveIntercept(Shooter, ProjectileSpeed, TrackPosition, TrackVelocity, OutIntercept)
+        && OutIntercept.Time <= MaxInterceptTime;
+}
+
+float AAAActor::EstimateKillProbability(float InterceptTime) const
+{
+    return MelSim::EstimateKillProbability(KillProbability, InterceptTime, MaxInterceptTime);
+}
+
+void AAAActor::FireAt(AMissleActor* TargetMissile, const MelSim::FInterceptSolution& Intercept, float ShotKillProbability)
+{
+    // Пуск в точку встречи - решение посчитано при распределении целей
+    const FVector SpawnLocation = GetActorLocation();
+    const FRotator SpawnRotation = MelSim::ToUE(Intercept.Direction).Rotation();
+
+    // Берем снаряд из пула
+    AAAProjectileActor* Projectile = nullptr;
+    if (ActorPool)
     {
-        GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Orange, TEXT("ПВО: Нет цели для стрельбы"));
-        return;
+        Projectile = ActorPool->Acquire<AAAProjectileActor>(ProjectileClass, FTransform(SpawnRotation, SpawnLocation), this);
     }
-    
-    if (!ProjectileClass) 
+    else
     {
-        GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("ПВО: Не указан класс снаряда!"));
-        return;
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Owner = this;
+        Projectile = GetWorld()->SpawnActor<AAAProjectileActor>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
     }
-
-    FVector SpawnLocation = GetActorLocation();
-    FRotator SpawnRotation = (TargetMissile->GetActorLocation() - SpawnLocation).Rotation();
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.Owner = this;
-
-    // Спавним снаряд
-    AAAProjectileActor* Projectile = GetWorld()->SpawnActor<AAAProjectileActor>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
     if (Projectile)
     {
-        Projectile->InitProjectile(TargetMissile, InitialForwardDistance, ProjectileSpeed);
-        TimeSinceLastFire = 0.0f;
+        Projectile->InitProjectile(TargetMissile, InitialForwardDistance, ProjectileSpeed, ShotKillProbability);
+        ReadyTime = UEngagementClockSubsystem::GetEngagementTime(GetWorld()) + FireInterval;
+        INC_DWORD_STAT(STAT_MelShots);
+
+        if (EngagementClock)
+        {
+            EngagementClock->RecordFire(SpawnLocation, TargetMissile->GetActorLocation());
+        }
         
         // Отладочное сообщение
-        GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, TEXT("ПВО: Запуск снаряда по ракете!"));
+        MEL_DEBUG(Info, this, 2.0f, FColor::Green, TEXT("ПВО: Запуск снаряда по ракете! (вероятность поражения %.2f)"), ShotKillProbability);
     }
     else
     {
-        GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("ПВО: Ошибка создания снаряда!"));
+        MEL_DEBUG(Error, this, 2.0f, FColor::Red, TEXT("ПВО: Ошибка создания снаряда!"));
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
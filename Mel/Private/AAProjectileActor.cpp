@@ -1,134 +1,89 @@
 #include "AAProjectileActor.h"
 #include "MissleActor.h"
-#include "GameFramework/ProjectileMovementComponent.h"
+#include "ProjectileGuidanceSubsystem.h"
+#include "MelSimBridge.h"
 #include "Engine/World.h"
 #include "Components/StaticMeshComponent.h"
-#include "DrawDebugHelpers.h"
 
 AAAProjectileActor::AAAProjectileActor()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Полет ведет пакет наведения
+    PrimaryActorTick.bCanEverTick = false;
     Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
     RootComponent = Mesh;
-    TargetMissile = nullptr;
-    TravelledDistance = 0.0f;
-    bIsHoming = false;
+    GuidanceSystem = nullptr;
+    GuidanceId = INDEX_NONE;
+    KillProbability = 0.0f;
+    bPooledIdle = false;
     
-    // Настройка коллизий
-    Mesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-    Mesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-    Mesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+    // Попадания считает пакет наведения по пространственному индексу ракет,
+    // физическая коллизия только удорожала бы перемещение меша каждый шаг
+    Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Mesh->SetGenerateOverlapEvents(false);
 }
 
 void AAAProjectileActor::BeginPlay()
 {
     Super::BeginPlay();
-    StartLocation = GetActorLocation();
-    TravelledDistance = 0.0f;
-    bIsHoming = false;
+    GuidanceSystem = GetWorld()->GetSubsystem<UProjectileGuidanceSubsystem>();
+
+    // Снаряд без InitProjectile летит прямо
+    if (!bPooledIdle && GuidanceId == INDEX_NONE)
+    {
+        StartFlight(nullptr);
+    }
 }
 
-void AAAProjectileActor::InitProjectile(AMissleActor* Target, float InForwardDistance, float InSpeed)
+void AAAProjectileActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StopFlight();
+    Super::EndPlay(EndPlayReason);
+}
+
+void AAAProjectileActor::InitProjectile(AMissleActor* Target, float InForwardDistance, float InSpeed, float InKillProbability)
 {
-    TargetMissile = Target;
     ForwardDistance = InForwardDistance;
     Speed = InSpeed;
-    bIsHoming = false;
+    KillProbability = InKillProbability;
+    StartFlight(Target);
 }
 
-void AAAProjectileActor::Tick(float DeltaTime)
+void AAAProjectileActor::OnAcquiredFromPool()
 {
-    Super::Tick(DeltaTime);
-    FVector CurrentLocation = GetActorLocation();
-    FVector ForwardVector = GetActorForwardVector();
+    bPooledIdle = false;
+    KillProbability = 0.0f;
+    StartFlight(nullptr);
+}
 
-    if (!bIsHoming)
-    {
-        FVector NewLocation = CurrentLocation + ForwardVector * Speed * DeltaTime;
-        SetActorLocation(NewLocation);
-        TravelledDistance += (NewLocation - CurrentLocation).Size();
-        if (TravelledDistance >= ForwardDistance)
-        {
-            bIsHoming = true;
-        }
-    }
-    else if (TargetMissile && TargetMissile->IsValidLowLevel())
-    {
-        // Улучшенное наведение с предсказанием
-        FVector TargetLocation = TargetMissile->GetActorLocation();
-        FVector TargetVelocity = FVector::ZeroVector;
-        
-        // Получаем скорость цели
-        UMovementComponent* MovementComp = TargetMissile->FindComponentByClass<UMovementComponent>();
-        if (MovementComp)
-        {
-            TargetVelocity = MovementComp->Velocity;
-        }
-        
-        // Предсказываем позицию цели
-        float TimeToTarget = FVector::Dist(CurrentLocation, TargetLocation) / Speed;
-        FVector PredictedTargetLocation = TargetLocation + TargetVelocity * TimeToTarget;
-        
-        // Направление к предсказанной позиции
-        FVector ToTarget = (PredictedTargetLocation - CurrentLocation).GetSafeNormal();
-        FVector NewLocation = CurrentLocation + ToTarget * Speed * DeltaTime;
-        SetActorLocation(NewLocation);
-        SetActorRotation(ToTarget.Rotation());
-        
-        // Проверяем близость к цели
-        float DistanceToTarget = FVector::Dist(CurrentLocation, TargetLocation);
-        if (DistanceToTarget < 200.0f) // 2 метра
-        {
-            // Попадание!
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("ПВО: Попадание!"));
-            
-            // Уничтожаем ракету
-            if (TargetMissile && TargetMissile->IsValidLowLevel())
-            {
-                TargetMissile->Destroy();
-            }
-            
-            // Уничтожаем снаряд
-            Destroy();
-            return;
-        }
-    }
-    else
-    {
-        // Нет цели — летим прямо
-        FVector NewLocation = CurrentLocation + ForwardVector * Speed * DeltaTime;
-        SetActorLocation(NewLocation);
-    }
-    
-    // Проверяем столкновения с ракетами
-    CheckCollisionWithMissiles();
+void AAAProjectileActor::OnReleasedToPool()
+{
+    bPooledIdle = true;
+    StopFlight();
 }
 
-void AAAProjectileActor::CheckCollisionWithMissiles()
+void AAAProjectileActor::StartFlight(AMissleActor* Target)
 {
-    FVector CurrentLocation = GetActorLocation();
-    
-    // Ищем все ракеты в радиусе
-    TArray<AActor*> FoundMissiles;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AMissleActor::StaticClass(), FoundMissiles);
-    
-    for (AActor* Actor : FoundMissiles)
+    StopFlight();
+    if (!GuidanceSystem)
+        return;
+
+    // Пройденный путь, наведение и время полета начинаются заново с текущего трансформа
+    MelSim::FProjectileState State = MelSim::MakeProjectile(MelSim::ToSim(GetActorLocation()),
+        MelSim::ToSim(GetActorForwardVector()), -1, ForwardDistance, Speed);
+    State.KillProbability = Target ? KillProbability : 0.0f;
+    GuidanceId = GuidanceSystem->RegisterProjectile(this, State, Target);
+}
+
+void AAAProjectileActor::StopFlight()
+{
+    if (GuidanceSystem && GuidanceId != INDEX_NONE)
     {
-        if (Actor && Actor->IsValidLowLevel())
-        {
-            float Distance = FVector::Dist(CurrentLocation, Actor->GetActorLocation());
-            if (Distance < 300.0f) // 3 метра
-            {
-                // Попадание!
-                GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("ПВО: Попадание по близости!"));
-                
-                // Уничтожаем ракету
-                Actor->Destroy();
-                
-                // Уничтожаем снаряд
-                Destroy();
-                return;
-            }
-        }
+        GuidanceSystem->UnregisterProjectile(GuidanceId);
     }
-} 
\ No newline at end of file
+    GuidanceId = INDEX_NONE;
+}
+
+void AAAProjectileActor::ApplyBatchedGuidance(const FVector& NewLocation, const FVector& NewForward)
+{
+    SetActorLocationAndRotation(NewLocation, NewForward.Rotation());
+}
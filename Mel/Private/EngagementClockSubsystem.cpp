@@ -0,0 +1,321 @@
+#include "EngagementClockSubsystem.h"
+#include "Mel.h"
+#include "MissileMovementSubsystem.h"
+#include "RadarNetworkSubsystem.h"
+#include "FireControlSubsystem.h"
+#include "ProjectileGuidanceSubsystem.h"
+#include "MissileWaveSubsystem.h"
+#include "MelStats.h"
+#include "MelSimBridge.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarEngagementFixedStep(
+    TEXT("mel.Engagement.FixedStep"),
+    1,
+    TEXT("1 - ракеты, радары, ПВО и снаряды шагают по фиксированным часам боя, 0 - по DeltaTime кадра"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEngagementStepRate(
+    TEXT("mel.Engagement.StepRate"),
+    60.0f,
+    TEXT("Частота шагов часов боя (Гц). Читается при создании мира."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEngagementMaxSteps(
+    TEXT("mel.Engagement.MaxStepsPerFrame"),
+    8,
+    TEXT("Максимум шагов боя за кадр; остаток времени долгого кадра отбрасывается"),
+    ECVF_Default);
+
+static FString ResolveLogPath(const FString& FileName)
+{
+    return FPaths::IsRelative(FileName) ? FPaths::Combine(FPaths::ProjectSavedDir(), FileName) : FileName;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdSaveEngagementLog(
+    TEXT("mel.Engagement.SaveLog"),
+    TEXT("Сохранить журнал боя: mel.Engagement.SaveLog <файл> (относительно Saved)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UEngagementClockSubsystem* EngagementClock = World ? World->GetSubsystem<UEngagementClockSubsystem>() : nullptr;
+        if (EngagementClock && Args.Num() > 0)
+        {
+            EngagementClock->SaveLog(Args[0]);
+        }
+    }));
+
+bool UEngagementClockSubsystem::IsFixedStepEnabled()
+{
+    return CVarEngagementFixedStep.GetValueOnGameThread() != 0;
+}
+
+float UEngagementClockSubsystem::GetEngagementTime(const UWorld* World)
+{
+    if (!World)
+        return 0.0f;
+
+    const UEngagementClockSubsystem* EngagementClock = World->GetSubsystem<UEngagementClockSubsystem>();
+    if (EngagementClock && IsFixedStepEnabled())
+    {
+        return EngagementClock->Clock.GetTime();
+    }
+    return World->GetTimeSeconds();
+}
+
+FRandomStream& UEngagementClockSubsystem::GetRandomStream(const UWorld* World)
+{
+    if (UEngagementClockSubsystem* EngagementClock = World ? World->GetSubsystem<UEngagementClockSubsystem>() : nullptr)
+    {
+        return EngagementClock->RandomStream;
+    }
+
+    static FRandomStream FallbackStream(static_cast<int32>(FPlatformTime::Cycles()));
+    return FallbackStream;
+}
+
+void UEngagementClockSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    MovementSystem = Collection.InitializeDependency<UMissileMovementSubsystem>();
+    RadarNetwork = Collection.InitializeDependency<URadarNetworkSubsystem>();
+    FireControl = Collection.InitializeDependency<UFireControlSubsystem>();
+    ProjectileGuidance = Collection.InitializeDependency<UProjectileGuidanceSubsystem>();
+    WaveScheduler = Collection.InitializeDependency<UMissileWaveSubsystem>();
+
+    TickFunction.Target = this;
+    TickFunction.TickGroup = TG_PrePhysics;
+    TickFunction.bCanEverTick = true;
+    TickFunction.bStartWithTickEnabled = true;
+    TickFunction.bHighPriority = true;
+
+    Clock = MelSim::FFixedStepClock();
+    Clock.StepTime = 1.0f / FMath::Max(CVarEngagementStepRate.GetValueOnGameThread(), 1.0f);
+    Clock.MaxStepsPerFrame = FMath::Max(CVarEngagementMaxSteps.GetValueOnGameThread(), 1);
+
+    bReplaying = false;
+    bDiverged = false;
+    Stats = MelSim::FEngagementStats();
+    Timings = FMelEngagementTimings();
+
+    // Повтор: зерно и длина шага берутся из записанного журнала
+    uint32 Seed = FPlatformTime::Cycles();
+    FString ReplayFileName;
+    if (FParse::Value(FCommandLine::Get(), TEXT("MelReplay="), ReplayFileName))
+    {
+        TArray<uint8> Bytes;
+        if (FFileHelper::LoadFileToArray(Bytes, *ResolveLogPath(ReplayFileName)) && ReferenceLog.Load(Bytes.GetData(), Bytes.Num()))
+        {
+            bReplaying = true;
+            Seed = ReferenceLog.Seed;
+            Clock.StepTime = ReferenceLog.StepTime;
+        }
+        else
+        {
+            UE_LOG(LogMel, Error, TEXT("Бой: не удалось загрузить журнал %s"), *ReplayFileName);
+        }
+    }
+    else
+    {
+        FParse::Value(FCommandLine::Get(), TEXT("MelSeed="), Seed);
+    }
+
+    FParse::Value(FCommandLine::Get(), TEXT("MelRecord="), RecordFileName);
+
+    RandomStream.Initialize(static_cast<int32>(Seed));
+    Log.Reset(Seed, Clock.StepTime);
+}
+
+void UEngagementClockSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+
+    if (!RecordFileName.IsEmpty())
+    {
+        SaveLog(RecordFileName);
+    }
+
+    Super::Deinitialize();
+}
+
+void UEngagementClockSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Часы тикают только в мире, где идет игра
+    if (!TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+    }
+}
+
+void UEngagementClockSubsystem::AddStepPrerequisite(AActor* Actor)
+{
+    if (Actor)
+    {
+        Actor->PrimaryActorTick.AddPrerequisite(this, TickFunction);
+    }
+}
+
+void UEngagementClockSubsystem::Tick(float DeltaTime)
+{
+    if (!IsFixedStepEnabled())
+    {
+        // Без фиксированных часов - один шаг на кадр, номер шага в журнале - номер кадра
+        Step(DeltaTime);
+        ++Clock.StepIndex;
+        return;
+    }
+
+    const int32 NumSteps = MelSim::AdvanceClock(Clock, DeltaTime);
+    for (int32 i = 0; i < NumSteps; ++i)
+    {
+        Step(Clock.StepTime);
+        ++Clock.StepIndex;
+    }
+}
+
+void UEngagementClockSubsystem::Step(float Dt)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MelEngagementStep);
+
+    // Порядок как в MelSim::FEngagement::Step: ракеты, радары, батареи, снаряды
+    double PhaseStart = FPlatformTime::Seconds();
+    auto EndPhase = [&PhaseStart](double& PhaseSeconds)
+    {
+        const double PhaseEnd = FPlatformTime::Seconds();
+        PhaseSeconds += PhaseEnd - PhaseStart;
+        PhaseStart = PhaseEnd;
+    };
+
+    // Пуски волн привязаны к шагу: ракета входит в пакет до шага ракет, пуск пишется в журнал с номером этого шага
+    if (WaveScheduler)
+    {
+        WaveScheduler->LaunchDueMissiles();
+    }
+
+    if (MovementSystem)
+    {
+        MovementSystem->StepMissiles(Dt);
+    }
+    EndPhase(Timings.MissileSeconds);
+
+    if (RadarNetwork)
+    {
+        RadarNetwork->StepRadars(Dt);
+    }
+    EndPhase(Timings.RadarSeconds);
+
+    if (FireControl)
+    {
+        FireControl->StepFireControl(Dt);
+    }
+    EndPhase(Timings.FireControlSeconds);
+
+    if (ProjectileGuidance)
+    {
+        ProjectileGuidance->StepProjectiles(Dt);
+    }
+    EndPhase(Timings.ProjectileSeconds);
+
+    ++Stats.Steps;
+}
+
+void UEngagementClockSubsystem::Record(MelSim::EReplayEventType Type, const FVector& Position, const FVector& Target)
+{
+    MelSim::FReplayEvent Event;
+    Event.Step = static_cast<int32>(Clock.StepIndex);
+    Event.Type = Type;
+    Event.Position = MelSim::ToSim(Position);
+    Event.Target = MelSim::ToSim(Target);
+    Log.Add(Event);
+
+    if (!bReplaying || bDiverged)
+        return;
+
+    // Сверка с записанным журналом: первое расхождение сообщается один раз
+    const int32 EventIndex = Log.Num() - 1;
+    if (EventIndex >= ReferenceLog.Num() || ReferenceLog.GetEvents()[EventIndex] != Event)
+    {
+        bDiverged = true;
+        UE_LOG(LogMel, Error, TEXT("Бой: повтор разошелся с журналом на событии %d (шаг %d)"), EventIndex, Event.Step);
+    }
+}
+
+void UEngagementClockSubsystem::RecordRadar(const FVector& Location)
+{
+    Record(MelSim::EReplayEventType::Radar, Location, FVector::ZeroVector);
+}
+
+void UEngagementClockSubsystem::RecordBattery(const FVector& Location)
+{
+    Record(MelSim::EReplayEventType::Battery, Location, FVector::ZeroVector);
+}
+
+void UEngagementClockSubsystem::RecordMissile(const FVector& LaunchPoint, const FVector& TargetPoint)
+{
+    ++Stats.MissilesLaunched;
+    Record(MelSim::EReplayEventType::Missile, LaunchPoint, TargetPoint);
+}
+
+void UEngagementClockSubsystem::RecordFire(const FVector& BatteryLocation, const FVector& TargetLocation)
+{
+    ++Stats.ProjectilesFired;
+    Record(MelSim::EReplayEventType::Fire, BatteryLocation, TargetLocation);
+}
+
+void UEngagementClockSubsystem::RecordIntercept()
+{
+    ++Stats.MissilesIntercepted;
+}
+
+void UEngagementClockSubsystem::RecordImpact()
+{
+    ++Stats.MissilesImpacted;
+}
+
+bool UEngagementClockSubsystem::SaveLog(const FString& FileName) const
+{
+    std::vector<uint8_t> Bytes;
+    Log.Save(Bytes);
+
+    const FString Path = ResolveLogPath(FileName);
+    const bool bSaved = FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Bytes.data(), static_cast<int32>(Bytes.size())), *Path);
+    if (bSaved)
+    {
+        UE_LOG(LogMel, Log, TEXT("Бой: журнал %s (%d событий)"), *Path, Log.Num());
+    }
+    else
+    {
+        UE_LOG(LogMel, Error, TEXT("Бой: не удалось записать журнал %s"), *Path);
+    }
+    return bSaved;
+}
+
+void FMelEngagementTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->Tick(DeltaTime);
+    }
+}
+
+FString FMelEngagementTickFunction::DiagnosticMessage()
+{
+    return TEXT("FMelEngagementTickFunction");
+}
+
+FName FMelEngagementTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("MelEngagementClock"));
+}
@@ -0,0 +1,178 @@
+#include "FireControlSubsystem.h"
+#include "AAActor.h"
+#include "MissleActor.h"
+#include "RadarNetworkSubsystem.h"
+#include "ProjectileGuidanceSubsystem.h"
+#include "EngagementClockSubsystem.h"
+#include "MelDebug.h"
+#include "MelStats.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarFireControlRate(
+    TEXT("mel.FireControl.Rate"),
+    10.0f,
+    TEXT("Частота распределения целей между батареями ПВО (Гц)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarFireControlMinKillGain(
+    TEXT("mel.FireControl.MinKillGain"),
+    0.1f,
+    TEXT("Выстрел назначается, если повышает вероятность поражения цели не меньше чем на эту величину"),
+    ECVF_Default);
+
+void UFireControlSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    RadarNetwork = Collection.InitializeDependency<URadarNetworkSubsystem>();
+    ProjectileGuidance = Collection.InitializeDependency<UProjectileGuidanceSubsystem>();
+    TimeSinceAssignment = 0.0f;
+    NextReadyTime = 0.0f;
+    bHasTargets = false;
+    SeenDetectionRevision = 0;
+}
+
+void UFireControlSubsystem::Deinitialize()
+{
+    Batteries.Reset();
+    Targets.Reset();
+    TargetSurvivals.Reset();
+    TargetIndexByMissile.Reset();
+    ShooterBatteries.Reset();
+    OptionIntercepts.Reset();
+    Assignment.Reset();
+
+    Super::Deinitialize();
+}
+
+void UFireControlSubsystem::RegisterBattery(AAAActor* Battery)
+{
+    if (Battery)
+    {
+        Batteries.AddUnique(Battery);
+        NextReadyTime = FMath::Min(NextReadyTime, Battery->GetReadyTime());
+    }
+}
+
+void UFireControlSubsystem::UnregisterBattery(AAAActor* Battery)
+{
+    // RemoveSingle сохраняет порядок регистрации - от него зависит выбор при равных вариантах
+    Batteries.RemoveSingle(Battery);
+}
+
+void UFireControlSubsystem::StepFireControl(float DeltaTime)
+{
+    // Цели распределяются не чаще периода, а не каждый кадр
+    const float AssignmentInterval = 1.0f / FMath::Max(CVarFireControlRate.GetValueOnGameThread(), 0.1f);
+    TimeSinceAssignment += DeltaTime;
+    if (TimeSinceAssignment < AssignmentInterval)
+        return;
+
+    // Спящее распределение не стоит ничего; проснувшись, оно выполняется в том же шаге
+    const float Now = UEngagementClockSubsystem::GetEngagementTime(GetWorld());
+    const bool bNewDetections = RadarNetwork && RadarNetwork->GetDetectionRevision() != SeenDetectionRevision;
+    if ((!bHasTargets && !bNewDetections) || Now < NextReadyTime)
+    {
+        TimeSinceAssignment = AssignmentInterval;
+        return;
+    }
+
+    // Долгий кадр не копит пропущенные распределения
+    TimeSinceAssignment = FMath::Min(TimeSinceAssignment - AssignmentInterval, AssignmentInterval);
+    AssignTargets(Now);
+
+    // Выстрелы сдвинули время готовности батарей
+    NextReadyTime = MAX_flt;
+    for (const AAAActor* Battery : Batteries)
+    {
+        NextReadyTime = FMath::Min(NextReadyTime, Battery->GetReadyTime());
+    }
+}
+
+void UFireControlSubsystem::AssignTargets(float Now)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MelFireControl);
+
+    Assignment.Reset();
+    Targets.Reset();
+    TargetIndexByMissile.Reset();
+
+    // Цели - подтвержденные слитые треки сети: ракета в зоне нескольких радаров - одна цель.
+    // Дальность и встреча считаются по оценке слитого трека, а не по истинному положению ракеты.
+    if (RadarNetwork)
+    {
+        SeenDetectionRevision = RadarNetwork->GetDetectionRevision();
+        for (const FRadarFusedTrack& Track : RadarNetwork->GetFusedTracks(Now))
+        {
+            TargetIndexByMissile.Add(Track.Missile, Targets.Num());
+            Targets.Add(Track);
+        }
+    }
+
+    bHasTargets = Targets.Num() > 0;
+    if (!bHasTargets)
+        return;
+
+    // Снаряды в полете уже снижают выживаемость своих целей
+    TargetSurvivals.Init(1.0f, Targets.Num());
+    if (ProjectileGuidance)
+    {
+        ProjectileGuidance->VisitTargetedProjectiles([this](AMissleActor* Target, const MelSim::FProjectileState& State)
+        {
+            if (const int32* TargetIndex = TargetIndexByMissile.Find(Target))
+            {
+                TargetSurvivals[*TargetIndex] *= 1.0f - State.KillProbability;
+            }
+        });
+    }
+
+    for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+    {
+        Assignment.AddTarget(Targets[TargetIndex].ThreatLevel, TargetSurvivals[TargetIndex]);
+    }
+
+    // Варианты выстрела готовых батарей по целям в радиусе действия с решением встречи
+    ShooterBatteries.Reset();
+    OptionIntercepts.Reset();
+    for (AAAActor* Battery : Batteries)
+    {
+        if (!Battery->IsReadyToFire())
+            continue;
+
+        const int32 Shooter = Assignment.AddShooter();
+        ShooterBatteries.Add(Battery);
+
+        for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+        {
+            const FRadarFusedTrack& Target = Targets[TargetIndex];
+            if (!Battery->IsInRange(Target.Position))
+                continue;
+
+            MelSim::FInterceptSolution Intercept;
+            if (!Battery->SolveFireControl(Target, Intercept))
+                continue;
+
+            Assignment.AddOption(Shooter, TargetIndex, Battery->EstimateKillProbability(Intercept.Time));
+            OptionIntercepts.Add(Intercept);
+        }
+    }
+
+    if (ShooterBatteries.Num() == 0)
+        return;
+
+    Assignment.Solve(CVarFireControlMinKillGain.GetValueOnGameThread());
+
+    int32 NumAssigned = 0;
+    for (int32 Shooter = 0; Shooter < ShooterBatteries.Num(); ++Shooter)
+    {
+        const int32 OptionIndex = Assignment.GetAssignedOption(Shooter);
+        if (OptionIndex == INDEX_NONE)
+            continue;
+
+        const MelSim::FWeaponTargetAssignment::FOption& Option = Assignment.GetOption(OptionIndex);
+        ShooterBatteries[Shooter]->FireAt(Targets[Option.Target].Missile, OptionIntercepts[OptionIndex], Option.KillProbability);
+        ++NumAssigned;
+    }
+
+    MEL_DEBUG(Verbose, this, 0.5f, FColor::Cyan, TEXT("Управление огнем: целей %d, готовых батарей %d, назначено %d"),
+        Targets.Num(), ShooterBatteries.Num(), NumAssigned);
+}
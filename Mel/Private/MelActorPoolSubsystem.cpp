@@ -0,0 +1,156 @@
+#include "MelActorPoolSubsystem.h"
+#include "MelPoolable.h"
+#include "Engine/World.h"
+
+void UMelActorPoolSubsystem::Deinitialize()
+{
+    // Акторы уничтожает сам мир
+    FreeActorsByClass.Empty();
+    PooledActors.Empty();
+    FreeActors.Empty();
+
+    Super::Deinitialize();
+}
+
+AActor* UMelActorPoolSubsystem::SpawnPooled(UClass* ActorClass)
+{
+    UWorld* World = GetWorld();
+    if (!World || !ActorClass)
+        return nullptr;
+
+    AActor* Actor = World->SpawnActorDeferred<AActor>(ActorClass, FTransform::Identity, nullptr, nullptr,
+        ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (!Actor)
+        return nullptr;
+
+    // Актор помечается свободным до BeginPlay, чтобы не стартовать полет в начале координат
+    if (IMelPoolable* Poolable = Cast<IMelPoolable>(Actor))
+    {
+        Poolable->OnReleasedToPool();
+    }
+    Actor->FinishSpawning(FTransform::Identity);
+    Deactivate(Actor);
+
+    PooledActors.Add(Actor);
+    return Actor;
+}
+
+void UMelActorPoolSubsystem::Deactivate(AActor* Actor)
+{
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+    Actor->SetOwner(nullptr);
+}
+
+void UMelActorPoolSubsystem::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+    if (!ActorClass || Count <= 0)
+        return;
+
+    TArray<TWeakObjectPtr<AActor>>& FreeList = FreeActorsByClass.FindOrAdd(ActorClass);
+    FreeList.Reserve(FreeList.Num() + Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        if (AActor* Actor = SpawnPooled(ActorClass))
+        {
+            FreeList.Add(Actor);
+            FreeActors.Add(Actor);
+        }
+    }
+}
+
+AActor* UMelActorPoolSubsystem::Acquire(TSubclassOf<AActor> ActorClass, const FTransform& Transform, AActor* Owner)
+{
+    if (!ActorClass)
+        return nullptr;
+
+    AActor* Actor = nullptr;
+    if (TArray<TWeakObjectPtr<AActor>>* FreeList = FreeActorsByClass.Find(ActorClass))
+    {
+        while (!Actor && FreeList->Num() > 0)
+        {
+            const TWeakObjectPtr<AActor> Candidate = FreeList->Pop(EAllowShrinking::No);
+            FreeActors.Remove(Candidate);
+
+            // Свободный актор мог быть уничтожен извне (например, при выгрузке уровня)
+            if (IsValid(Candidate.Get()))
+            {
+                Actor = Candidate.Get();
+            }
+            else
+            {
+                PooledActors.Remove(Candidate);
+            }
+        }
+    }
+
+    if (!Actor)
+    {
+        Actor = SpawnPooled(ActorClass);
+        if (!Actor)
+            return nullptr;
+    }
+
+    Actor->SetOwner(Owner);
+    Actor->SetActorLocationAndRotation(Transform.GetLocation(), Transform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+    Actor->SetActorHiddenInGame(false);
+    Actor->SetActorEnableCollision(true);
+    Actor->SetActorTickEnabled(true);
+
+    if (IMelPoolable* Poolable = Cast<IMelPoolable>(Actor))
+    {
+        Poolable->OnAcquiredFromPool();
+    }
+    return Actor;
+}
+
+void UMelActorPoolSubsystem::Release(AActor* Actor)
+{
+    if (!IsValid(Actor))
+        return;
+
+    const TWeakObjectPtr<AActor> PooledActor(Actor);
+    if (!PooledActors.Contains(PooledActor))
+    {
+        Actor->Destroy();
+        return;
+    }
+
+    // Повторный возврат (ракету сбили два снаряда за кадр) ничего не делает
+    bool bAlreadyFree = false;
+    FreeActors.Add(PooledActor, &bAlreadyFree);
+    if (bAlreadyFree)
+        return;
+
+    if (IMelPoolable* Poolable = Cast<IMelPoolable>(Actor))
+    {
+        Poolable->OnReleasedToPool();
+    }
+    Deactivate(Actor);
+
+    FreeActorsByClass.FindOrAdd(Actor->GetClass()).Add(PooledActor);
+}
+
+void UMelActorPoolSubsystem::ReleaseOrDestroy(AActor* Actor)
+{
+    if (!IsValid(Actor))
+        return;
+
+    UWorld* World = Actor->GetWorld();
+    UMelActorPoolSubsystem* Pool = World ? World->GetSubsystem<UMelActorPoolSubsystem>() : nullptr;
+    if (Pool)
+    {
+        Pool->Release(Actor);
+    }
+    else
+    {
+        Actor->Destroy();
+    }
+}
+
+int32 UMelActorPoolSubsystem::GetNumFree(TSubclassOf<AActor> ActorClass) const
+{
+    const TArray<TWeakObjectPtr<AActor>>* FreeList = FreeActorsByClass.Find(ActorClass);
+    return FreeList ? FreeList->Num() : 0;
+}
@@ -0,0 +1,280 @@
+#include "MelBenchmarkGameMode.h"
+#include "Mel.h"
+#include "MissleActor.h"
+#include "RadarActor.h"
+#include "AAActor.h"
+#include "AAProjectileActor.h"
+#include "MissileMovementSubsystem.h"
+#include "ProjectileGuidanceSubsystem.h"
+#include "MelActorPoolSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+// Память опрашивается раз в столько кадров: чтение статистики процесса не бесплатно
+static constexpr int32 MemorySampleFrames = 10;
+
+AMelBenchmarkGameMode::AMelBenchmarkGameMode()
+{
+    PrimaryActorTick.bCanEverTick = true;
+
+    MissileClass = AMissleActor::StaticClass();
+    RadarClass = ARadarActor::StaticClass();
+    BatteryClass = AAAActor::StaticClass();
+    ProjectileClass = AAAProjectileActor::StaticClass();
+    WaveSizes = { 100, 1000, 10000 };
+
+    EngagementClock = nullptr;
+    MovementSystem = nullptr;
+    ProjectileGuidance = nullptr;
+    WaveIndex = INDEX_NONE;
+    LastFrameTime = 0.0;
+}
+
+void AMelBenchmarkGameMode::BeginPlay()
+{
+    Super::BeginPlay();
+
+    ParseCommandLine();
+
+    // Время шагов по подсистемам меряют фиксированные часы боя
+    if (IConsoleVariable* FixedStep = IConsoleManager::Get().FindConsoleVariable(TEXT("mel.Engagement.FixedStep")))
+    {
+        FixedStep->Set(1, ECVF_SetByCode);
+    }
+
+    EngagementClock = GetWorld()->GetSubsystem<UEngagementClockSubsystem>();
+    MovementSystem = GetWorld()->GetSubsystem<UMissileMovementSubsystem>();
+    ProjectileGuidance = GetWorld()->GetSubsystem<UProjectileGuidanceSubsystem>();
+    if (!EngagementClock || !MovementSystem || !MissileClass)
+    {
+        UE_LOG(LogMel, Error, TEXT("Нагрузочный прогон: нет подсистем боя или класса ракеты"));
+        return;
+    }
+
+    SpawnDefenses();
+
+    // Ракеты самой большой волны создаются при загрузке, замер волны не включает создание акторов
+    int32 MaxWaveSize = 0;
+    for (int32 WaveSize : WaveSizes)
+    {
+        MaxWaveSize = FMath::Max(MaxWaveSize, WaveSize);
+    }
+    if (UMelActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMelActorPoolSubsystem>())
+    {
+        Pool->Prewarm(MissileClass, MaxWaveSize);
+    }
+
+    CsvRows.Reset();
+    CsvRows.Add(TEXT("Build,Wave,Missiles,Radars,Batteries,Frames,EngagementSeconds,FrameMsAvg,FrameMsMax,")
+                TEXT("MissileMs,RadarMs,FireControlMs,ProjectileMs,PeakMemoryMB,PeakProjectiles,")
+                TEXT("Launched,Killed,Leaked,Remaining,Fired"));
+
+    WaveIndex = 0;
+    StartWave();
+}
+
+void AMelBenchmarkGameMode::ParseCommandLine()
+{
+    const TCHAR* CommandLine = FCommandLine::Get();
+
+    FString Waves;
+    if (FParse::Value(CommandLine, TEXT("MelBenchWaves="), Waves, false))
+    {
+        TArray<FString> WaveTokens;
+        Waves.ParseIntoArray(WaveTokens, TEXT(","));
+        WaveSizes.Reset();
+        for (const FString& Token : WaveTokens)
+        {
+            WaveSizes.Add(FMath::Max(FCString::Atoi(*Token), 0));
+        }
+    }
+
+    FParse::Value(CommandLine, TEXT("MelBenchRadars="), NumRadars);
+    FParse::Value(CommandLine, TEXT("MelBenchBatteries="), NumBatteries);
+    FParse::Value(CommandLine, TEXT("MelBenchTimeout="), WaveTimeout);
+    FParse::Value(CommandLine, TEXT("MelBenchCsv="), CsvFileName);
+}
+
+void AMelBenchmarkGameMode::SpawnDefenses()
+{
+    // Радары и батареи равномерно по двум кольцам вокруг цели
+    for (int32 Index = 0; Index < NumRadars && RadarClass; ++Index)
+    {
+        const float Angle = 2.0f * PI * Index / NumRadars;
+        const FVector Location(FMath::Cos(Angle) * RadarRingRadius, FMath::Sin(Angle) * RadarRingRadius, 0.0f);
+        GetWorld()->SpawnActor<ARadarActor>(RadarClass, Location, FRotator::ZeroRotator);
+    }
+
+    for (int32 Index = 0; Index < NumBatteries && BatteryClass; ++Index)
+    {
+        const float Angle = 2.0f * PI * (Index + 0.5f) / NumBatteries;
+        const FTransform Transform(FVector(FMath::Cos(Angle) * BatteryRingRadius, FMath::Sin(Angle) * BatteryRingRadius, 0.0f));
+
+        // Класс снаряда нужен до BeginPlay батареи: в нем заполняется пул снарядов
+        AAAActor* Battery = GetWorld()->SpawnActorDeferred<AAAActor>(BatteryClass, Transform);
+        if (!Battery)
+            continue;
+
+        if (!Battery->HasProjectileClass())
+        {
+            Battery->SetProjectileClass(ProjectileClass);
+        }
+        Battery->FinishSpawning(Transform);
+    }
+}
+
+void AMelBenchmarkGameMode::StartWave()
+{
+    Wave = FWaveSample();
+    Wave.NumMissiles = WaveSizes[WaveIndex];
+    Wave.StartTime = UEngagementClockSubsystem::GetEngagementTime(GetWorld());
+    Wave.StartStats = EngagementClock->GetStats();
+    Wave.StartTimings = EngagementClock->GetTimings();
+
+    UMelActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMelActorPoolSubsystem>();
+    for (int32 Index = 0; Index < Wave.NumMissiles; ++Index)
+    {
+        const FTransform Transform(GetRandomEdgePosition(LaunchHalfSize));
+        if (Pool)
+        {
+            Pool->Acquire<AMissleActor>(MissileClass, Transform, this);
+        }
+        else
+        {
+            GetWorld()->SpawnActor<AMissleActor>(MissileClass, Transform);
+        }
+    }
+
+    // Кадр запуска волны в замер не входит
+    LastFrameTime = FPlatformTime::Seconds();
+}
+
+void AMelBenchmarkGameMode::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if (!WaveSizes.IsValidIndex(WaveIndex) || !EngagementClock)
+        return;
+
+    const double Now = FPlatformTime::Seconds();
+    const double FrameSeconds = Now - LastFrameTime;
+    LastFrameTime = Now;
+
+    ++Wave.NumFrames;
+    Wave.FrameSeconds += FrameSeconds;
+    Wave.MaxFrameSeconds = FMath::Max(Wave.MaxFrameSeconds, FrameSeconds);
+    if (ProjectileGuidance)
+    {
+        Wave.PeakProjectiles = FMath::Max(Wave.PeakProjectiles, ProjectileGuidance->GetNumProjectiles());
+    }
+    if (Wave.NumFrames % MemorySampleFrames == 0)
+    {
+        SampleMemory();
+    }
+
+    const float WaveTime = UEngagementClockSubsystem::GetEngagementTime(GetWorld()) - Wave.StartTime;
+    if (MovementSystem->GetNumMissiles() > 0 && WaveTime < WaveTimeout)
+        return;
+
+    FinishWave();
+
+    if (++WaveIndex < WaveSizes.Num())
+    {
+        StartWave();
+        return;
+    }
+
+    if (!GIsEditor)
+    {
+        FPlatformMisc::RequestExit(false);
+    }
+}
+
+void AMelBenchmarkGameMode::SampleMemory()
+{
+    Wave.PeakMemory = FMath::Max<uint64>(Wave.PeakMemory, FPlatformMemory::GetStats().UsedPhysical);
+}
+
+void AMelBenchmarkGameMode::FinishWave()
+{
+    SampleMemory();
+
+    const MelSim::FEngagementStats& Stats = EngagementClock->GetStats();
+    const FMelEngagementTimings& Timings = EngagementClock->GetTimings();
+    const double MsPerFrame = 1000.0 / FMath::Max(Wave.NumFrames, 1);
+
+    const int32 Launched = Stats.MissilesLaunched - Wave.StartStats.MissilesLaunched;
+    const int32 Killed = Stats.MissilesIntercepted - Wave.StartStats.MissilesIntercepted;
+    const int32 Leaked = Stats.MissilesImpacted - Wave.StartStats.MissilesImpacted;
+    const int32 Remaining = MovementSystem->GetNumMissiles();
+
+    const FString Row = FString::Printf(TEXT("%s,%d,%d,%d,%d,%d,%.2f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%d,%d,%d,%d,%d,%d"),
+        FApp::GetBuildVersion(), WaveIndex, Wave.NumMissiles, NumRadars, NumBatteries, Wave.NumFrames,
+        UEngagementClockSubsystem::GetEngagementTime(GetWorld()) - Wave.StartTime,
+        Wave.FrameSeconds * MsPerFrame, Wave.MaxFrameSeconds * 1000.0,
+        (Timings.MissileSeconds - Wave.StartTimings.MissileSeconds) * MsPerFrame,
+        (Timings.RadarSeconds - Wave.StartTimings.RadarSeconds) * MsPerFrame,
+        (Timings.FireControlSeconds - Wave.StartTimings.FireControlSeconds) * MsPerFrame,
+        (Timings.ProjectileSeconds - Wave.StartTimings.ProjectileSeconds) * MsPerFrame,
+        Wave.PeakMemory / (1024.0 * 1024.0), Wave.PeakProjectiles,
+        Launched, Killed, Leaked, Remaining,
+        Stats.ProjectilesFired - Wave.StartStats.ProjectilesFired);
+    CsvRows.Add(Row);
+
+    UE_LOG(LogMel, Display, TEXT("Нагрузочный прогон: волна %d (%d ракет) - кадр %.2f мс, сбито %d, прорвалось %d, в полете %d"),
+        WaveIndex, Wave.NumMissiles, Wave.FrameSeconds * MsPerFrame, Killed, Leaked, Remaining);
+
+    // Не долетевшие за отведенное время ракеты не переходят в следующую волну
+    if (Remaining > 0)
+    {
+        TArray<AActor*> InFlight;
+        for (TActorIterator<AMissleActor> It(GetWorld()); It; ++It)
+        {
+            if (It->IsInFlight())
+            {
+                InFlight.Add(*It);
+            }
+        }
+        for (AActor* Missile : InFlight)
+        {
+            UMelActorPoolSubsystem::ReleaseOrDestroy(Missile);
+        }
+    }
+
+    // Строки пишутся после каждой волны: прерванный прогон сохраняет готовые замеры
+    SaveCsv();
+}
+
+void AMelBenchmarkGameMode::SaveCsv() const
+{
+    const FString Path = FPaths::IsRelative(CsvFileName) ? FPaths::Combine(FPaths::ProjectSavedDir(), CsvFileName) : CsvFileName;
+    const bool bSaved = FFileHelper::SaveStringArrayToFile(CsvRows, *Path);
+    if (!bSaved)
+    {
+        UE_LOG(LogMel, Error, TEXT("Нагрузочный прогон: не удалось записать %s"), *Path);
+    }
+}
+
+FVector AMelBenchmarkGameMode::GetRandomEdgePosition(float Distance) const
+{
+    FRandomStream& Random = UEngagementClockSubsystem::GetRandomStream(GetWorld());
+    const int32 Edge = Random.RandRange(0, 3);
+    float X = 0.f, Y = 0.f;
+    switch (Edge)
+    {
+    case 0: X = Distance; Y = Random.FRandRange(-Distance, Distance); break;
+    case 1: X = -Distance; Y = Random.FRandRange(-Distance, Distance); break;
+    case 2: Y = Distance; X = Random.FRandRange(-Distance, Distance); break;
+    case 3: Y = -Distance; X = Random.FRandRange(-Distance, Distance); break;
+    }
+
+    return FVector(X, Y, 100.f);
+}
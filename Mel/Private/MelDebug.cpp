@@ -0,0 +1,70 @@
+#include "MelDebug.h"
+
+#if MEL_DEBUG_ENABLED
+
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+static TAutoConsoleVariable<int32> CVarMelDebugVerbosity(
+    TEXT("mel.Debug.Verbosity"),
+    static_cast<int32>(EMelDebugVerbosity::Info),
+    TEXT("Отладочные сообщения на экране: 0 - нет, 1 - ошибки, 2 - события боя, 3 - состояние каждый кадр"),
+    ECVF_Default);
+
+namespace
+{
+    struct FMelDebugEntry
+    {
+        double NextPrintTime = 0.0;
+        int32 NumSuppressed = 0;
+    };
+
+    // Только игровой поток: рабочие потоки скана сообщений не выводят
+    TMap<uint32, FMelDebugEntry> GMelDebugEntries;
+
+    // Ключи с контекстом-ракетой копятся; сверх лимита забываются давно показанные
+    constexpr int32 MaxDebugEntries = 1024;
+}
+
+bool FMelDebug::ShouldPrint(uint32 Key, EMelDebugVerbosity Verbosity, float Duration)
+{
+    if (!GEngine || !IsInGameThread() || static_cast<int32>(Verbosity) > CVarMelDebugVerbosity.GetValueOnGameThread())
+        return false;
+
+    const double Now = FPlatformTime::Seconds();
+    if (GMelDebugEntries.Num() >= MaxDebugEntries && !GMelDebugEntries.Contains(Key))
+    {
+        for (auto It = GMelDebugEntries.CreateIterator(); It; ++It)
+        {
+            if (It.Value().NextPrintTime < Now && It.Value().NumSuppressed == 0)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    FMelDebugEntry& Entry = GMelDebugEntries.FindOrAdd(Key);
+    if (Now < Entry.NextPrintTime)
+    {
+        ++Entry.NumSuppressed;
+        return false;
+    }
+
+    Entry.NextPrintTime = Now + Duration;
+    return true;
+}
+
+void FMelDebug::Print(uint32 Key, float Duration, const FColor& Color, FString&& Message)
+{
+    FMelDebugEntry& Entry = GMelDebugEntries.FindOrAdd(Key);
+    if (Entry.NumSuppressed > 0)
+    {
+        Message += FString::Printf(TEXT(" (+%d)"), Entry.NumSuppressed);
+        Entry.NumSuppressed = 0;
+    }
+
+    GEngine->AddOnScreenDebugMessage(static_cast<uint64>(Key), Duration, Color, Message);
+}
+
+#endif
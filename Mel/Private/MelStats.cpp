@@ -0,0 +1,30 @@
+#include "MelStats.h"
+
+DEFINE_STAT(STAT_MelEngagementStep);
+
+DEFINE_STAT(STAT_MelRadarStep);
+DEFINE_STAT(STAT_MelRadarAzimuthRefresh);
+DEFINE_STAT(STAT_MelRadarScan);
+DEFINE_STAT(STAT_MelRadarUpdateMissileData);
+DEFINE_STAT(STAT_MelRadarTrackFilter);
+DEFINE_STAT(STAT_MelRadarReport);
+DEFINE_STAT(STAT_MelRadarCleanup);
+DEFINE_STAT(STAT_MelRadarNetworkScan);
+DEFINE_STAT(STAT_MelRadarFusion);
+
+DEFINE_STAT(STAT_MelMissileStep);
+DEFINE_STAT(STAT_MelMissileBatch);
+DEFINE_STAT(STAT_MelMissileCollision);
+DEFINE_STAT(STAT_MelMissileSignificance);
+
+DEFINE_STAT(STAT_MelFireControl);
+DEFINE_STAT(STAT_MelProjectileStep);
+DEFINE_STAT(STAT_MelProjectileGuidance);
+DEFINE_STAT(STAT_MelProjectileCollision);
+
+DEFINE_STAT(STAT_MelRadarTracks);
+DEFINE_STAT(STAT_MelActiveMissiles);
+DEFINE_STAT(STAT_MelActiveProjectiles);
+DEFINE_STAT(STAT_MelRadarScans);
+DEFINE_STAT(STAT_MelShots);
+DEFINE_STAT(STAT_MelHits);
@@ -0,0 +1,114 @@
+#include "MissileMovementSubsystem.h"
+#include "MissleActor.h"
+#include "EngagementClockSubsystem.h"
+#include "MelSimBridge.h"
+#include "MelStats.h"
+
+TStatId UMissileMovementSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMissileMovementSubsystem, STATGROUP_Tickables);
+}
+
+int32 UMissileMovementSubsystem::RegisterMissile(AMissleActor* Missile, const MelSim::FMissileState& State, const MelSim::FMissileParams& Params)
+{
+    const int32 MissileId = Batch.Add(State, Params);
+    Missiles.Add(Missile);
+    Trajectories.Add(MelSim::BuildMissileTrajectory(State, Params, UEngagementClockSubsystem::GetEngagementTime(GetWorld())));
+    check(Missiles.Num() == Batch.Num());
+    return MissileId;
+}
+
+void UMissileMovementSubsystem::UnregisterMissile(int32 MissileId)
+{
+    const int32 Index = Batch.GetIndex(MissileId);
+    if (Index == INDEX_NONE)
+        return;
+
+    // Пакет переносит последний элемент на место удаленного - массив акторов повторяет это
+    Batch.Remove(MissileId);
+    Missiles.RemoveAtSwap(Index);
+    Trajectories.RemoveAtSwap(Index);
+}
+
+bool UMissileMovementSubsystem::GetMissileState(int32 MissileId, MelSim::FMissileState& OutState, MelSim::FMissileParams& OutParams) const
+{
+    const int32 Index = Batch.GetIndex(MissileId);
+    if (Index == INDEX_NONE)
+        return false;
+
+    OutState = Batch.GetState(Index);
+    OutParams = Batch.GetParams(Index);
+    return true;
+}
+
+const MelSim::FMissileTrajectory* UMissileMovementSubsystem::GetTrajectory(int32 MissileId) const
+{
+    const int32 Index = Batch.GetIndex(MissileId);
+    return Index != INDEX_NONE ? &Trajectories[Index] : nullptr;
+}
+
+bool UMissileMovementSubsystem::PredictImpact(int32 MissileId, float Now, float& OutTimeToImpact, FVector& OutImpactPoint) const
+{
+    const MelSim::FMissileTrajectory* Trajectory = GetTrajectory(MissileId);
+    if (!Trajectory)
+        return false;
+
+    OutTimeToImpact = MelSim::GetTimeToImpact(*Trajectory, Now);
+    OutImpactPoint = MelSim::ToUE(Trajectory->ImpactPoint);
+    return true;
+}
+
+void UMissileMovementSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SET_DWORD_STAT(STAT_MelActiveMissiles, Batch.Num());
+}
+
+void UMissileMovementSubsystem::StepMissiles(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MelMissileStep);
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_MelMissileBatch);
+        Batch.Step(DeltaTime);
+    }
+
+    const float Now = UEngagementClockSubsystem::GetEngagementTime(GetWorld());
+
+    // Один проход записи: трансформ, скорость для радаров, пространственный индекс
+    float MaxSpeedSquared = 0.0f;
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        AMissleActor* Missile = Missiles[Index];
+        const MelSim::FVec3 Velocity = Batch.GetVelocity(Index);
+
+        // Прогноз перестраивается только при смене фазы, между сменами профиль полета известен
+        if (Batch.GetPhase(Index) != Trajectories[Index].Phase)
+        {
+            Trajectories[Index] = MelSim::BuildMissileTrajectory(Batch.GetState(Index), Batch.GetParams(Index), Now);
+        }
+        MaxSpeedSquared = FMath::Max(MaxSpeedSquared, Velocity.SizeSquared());
+
+        const bool bHitGeometry = Missile->ApplyBatchedMovement(
+            MelSim::ToUE(Batch.GetPosition(Index)),
+            MelSim::ToUE(Velocity),
+            static_cast<EMisslePhase>(Batch.GetPhase(Index)),
+            DeltaTime);
+
+        // Полет заканчивается по тому же условию, что в ядре симуляции, и на карте без пола
+        if (bHitGeometry || Batch.HasReachedTarget(Index))
+        {
+            ExplodingMissiles.Add(Missile);
+        }
+    }
+
+    MaxMissileSpeed = FMath::Sqrt(MaxSpeedSquared);
+
+    // Взрыв уничтожает актор и удаляет его из пакета, поэтому выполняется после прохода
+    for (AMissleActor* Missile : ExplodingMissiles)
+    {
+        Missile->Explode();
+    }
+    ExplodingMissiles.Reset();
+}
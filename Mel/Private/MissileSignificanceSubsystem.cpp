@@ -0,0 +1,139 @@
+#include "MissileSignificanceSubsystem.h"
+#include "MissleActor.h"
+#include "MissileMovementSubsystem.h"
+#include "RadarNetworkSubsystem.h"
+#include "RadarActor.h"
+#include "MelStats.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarSignificanceEnable(
+    TEXT("mel.Significance.Enable"),
+    1,
+    TEXT("Снижать частоту поворота, звук и детализацию незначимых ракет (0 - все ракеты с полной детализацией)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSignificanceUpdatesPerFrame(
+    TEXT("mel.Significance.UpdatesPerFrame"),
+    512,
+    TEXT("Сколько ракет переоценивается за кадр"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceCameraDistance(
+    TEXT("mel.Significance.CameraDistance"),
+    50000.0f,
+    TEXT("Дальность от камеры, на которой вклад камеры в значимость ракеты падает до нуля"),
+    ECVF_Default);
+
+// Пороги оценки и вклады в нее
+static constexpr float HighScore = 0.5f;
+static constexpr float MediumScore = 0.2f;
+static constexpr float RadarScore = 0.3f;
+static constexpr float DescentBonus = 0.3f;
+static constexpr float AscendingBonus = 0.2f;
+
+TStatId UMissileSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMissileSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UMissileSignificanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    UMissileMovementSubsystem* MovementSystem = GetWorld()->GetSubsystem<UMissileMovementSubsystem>();
+    if (!MovementSystem)
+        return;
+
+    const TArray<AMissleActor*>& Missiles = MovementSystem->GetMissiles();
+    if (Missiles.Num() == 0)
+    {
+        Cursor = 0;
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_MelMissileSignificance);
+
+    const bool bEnabled = CVarSignificanceEnable.GetValueOnGameThread() != 0;
+    if (bEnabled)
+    {
+        GatherViewpoints();
+    }
+
+    // Плотные индексы переставляются при снятии ракет: за круг ракета может быть пропущена
+    // или оценена дважды, следующий круг это исправит
+    const int32 NumUpdates = FMath::Min(FMath::Max(CVarSignificanceUpdatesPerFrame.GetValueOnGameThread(), 1), Missiles.Num());
+    for (int32 Update = 0; Update < NumUpdates; ++Update)
+    {
+        if (Cursor >= Missiles.Num())
+        {
+            Cursor = 0;
+        }
+
+        AMissleActor* Missile = Missiles[Cursor++];
+        if (!bEnabled)
+        {
+            Missile->SetSignificance(EMissileSignificance::High);
+            continue;
+        }
+
+        const float Score = GetScore(Missile);
+        Missile->SetSignificance(Score >= HighScore ? EMissileSignificance::High
+                               : Score >= MediumScore ? EMissileSignificance::Medium
+                               : EMissileSignificance::Low);
+    }
+}
+
+void UMissileSignificanceSubsystem::GatherViewpoints()
+{
+    Viewpoints.Reset();
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PC = It->Get();
+        if (!PC || !PC->IsLocalController())
+            continue;
+
+        FVector Location;
+        FRotator Rotation;
+        PC->GetPlayerViewPoint(Location, Rotation);
+        Viewpoints.Add(Location);
+    }
+}
+
+float UMissileSignificanceSubsystem::GetScore(const AMissleActor* Missile) const
+{
+    const FVector Location = Missile->GetActorLocation();
+
+    // Без локального игрока (выделенный сервер, прогон без отрисовки) вклад камеры нулевой
+    float Score = 0.0f;
+    const float CameraDistance = FMath::Max(CVarSignificanceCameraDistance.GetValueOnGameThread(), 1.0f);
+    for (const FVector& Viewpoint : Viewpoints)
+    {
+        Score = FMath::Max(Score, 1.0f - FVector::Dist(Viewpoint, Location) / CameraDistance);
+    }
+
+    if (Score < RadarScore)
+    {
+        if (const URadarNetworkSubsystem* RadarNetwork = GetWorld()->GetSubsystem<URadarNetworkSubsystem>())
+        {
+            for (const ARadarActor* Radar : RadarNetwork->GetRadars())
+            {
+                if (FVector::DistSquared(Radar->GetActorLocation(), Location) <= FMath::Square(Radar->GetScanRadius()))
+                {
+                    Score = RadarScore;
+                    break;
+                }
+            }
+        }
+    }
+
+    switch (Missile->GetPhase())
+    {
+        case EMisslePhase::Descent:   Score += DescentBonus; break;
+        case EMisslePhase::Ascending: Score += AscendingBonus; break;
+        default: break;
+    }
+
+    return Score;
+}
@@ -0,0 +1,189 @@
+#include "MissileSpatialSubsystem.h"
+#include "MissleActor.h"
+
+FIntPoint UMissileSpatialSubsystem::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UMissileSpatialSubsystem::AddToCell(AMissleActor* Missile, const FVector& Location, const FIntPoint& Cell)
+{
+    TArray<FCellEntry>& Entries = Cells.FindOrAdd(Cell);
+    const int32 Slot = Entries.Add({ Missile, Location });
+    MissileCells.Add(Missile, { Cell, Slot });
+}
+
+void UMissileSpatialSubsystem::RemoveFromCell(const FCellRef& Ref)
+{
+    TArray<FCellEntry>* Entries = Cells.Find(Ref.Cell);
+    if (!Entries || !Entries->IsValidIndex(Ref.Slot))
+        return;
+
+    Entries->RemoveAtSwap(Ref.Slot);
+
+    // Последний элемент переехал на место удалённого - поправляем его ссылку
+    if (Entries->IsValidIndex(Ref.Slot))
+    {
+        MissileCells.FindChecked((*Entries)[Ref.Slot].Missile).Slot = Ref.Slot;
+    }
+
+    if (Entries->Num() == 0)
+    {
+        Cells.Remove(Ref.Cell);
+    }
+}
+
+void UMissileSpatialSubsystem::RegisterMissile(AMissleActor* Missile)
+{
+    if (!Missile || MissileCells.Contains(Missile))
+        return;
+
+    const FVector Location = Missile->GetActorLocation();
+    AddToCell(Missile, Location, GetCell(Location));
+}
+
+void UMissileSpatialSubsystem::UnregisterMissile(AMissleActor* Missile)
+{
+    FCellRef Ref;
+    if (!MissileCells.RemoveAndCopyValue(Missile, Ref))
+        return;
+
+    RemoveFromCell(Ref);
+}
+
+void UMissileSpatialSubsystem::UpdateMissile(AMissleActor* Missile)
+{
+    FCellRef* Ref = MissileCells.Find(Missile);
+    if (!Ref)
+        return;
+
+    const FVector Location = Missile->GetActorLocation();
+    const FIntPoint NewCell = GetCell(Location);
+
+    // Ракета осталась в своей ячейке - обновляем только координаты
+    if (NewCell == Ref->Cell)
+    {
+        Cells.FindChecked(NewCell)[Ref->Slot].Location = Location;
+        return;
+    }
+
+    const FCellRef OldRef = *Ref;
+    MissileCells.Remove(Missile);
+    RemoveFromCell(OldRef);
+    AddToCell(Missile, Location, NewCell);
+}
+
+template <typename PredicateType>
+void UMissileSpatialSubsystem::ForEachInRect(const FVector2D& Min, const FVector2D& Max, PredicateType&& Predicate) const
+{
+    const FIntPoint MinCell = GetCell(FVector(Min, 0.0f));
+    const FIntPoint MaxCell = GetCell(FVector(Max, 0.0f));
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            if (const TArray<FCellEntry>* Entries = Cells.Find(FIntPoint(X, Y)))
+            {
+                for (const FCellEntry& Entry : *Entries)
+                {
+                    Predicate(Entry);
+                }
+            }
+        }
+    }
+}
+
+void UMissileSpatialSubsystem::QueryRadius(const FVector& Center, float Radius, TArray<AMissleActor*>& OutMissiles) const
+{
+    const FVector2D Center2D(Center);
+    const float RadiusSquared = Radius * Radius;
+
+    ForEachInRect(Center2D - Radius, Center2D + Radius, [&](const FCellEntry& Entry)
+    {
+        if (FVector::DistSquared(Entry.Location, Center) <= RadiusSquared)
+        {
+            OutMissiles.Add(Entry.Missile);
+        }
+    });
+}
+
+void UMissileSpatialSubsystem::QueryBox(const FBox& Box, TArray<AMissleActor*>& OutMissiles) const
+{
+    ForEachInRect(FVector2D(Box.Min), FVector2D(Box.Max), [&](const FCellEntry& Entry)
+    {
+        if (Box.IsInsideOrOn(Entry.Location))
+        {
+            OutMissiles.Add(Entry.Missile);
+        }
+    });
+}
+
+FRadarSectorTest::FRadarSectorTest(const FRadarSectorQuery& Query)
+{
+    Origin2D = FVector2D(Query.Origin);
+    RadiusSquared = Query.Radius * Query.Radius;
+    MinHeight = Query.MinHeight;
+    MaxHeight = Query.MaxHeight;
+
+    // Сравниваем косинусы вместо Atan2: угол до оси сектора <= половины ширины
+    const float CenterAngleRad = FMath::DegreesToRadians(Query.CenterAngleDeg);
+    Axis = FVector2D(FMath::Cos(CenterAngleRad), FMath::Sin(CenterAngleRad));
+    CosHalfWidth = FMath::Cos(FMath::DegreesToRadians(Query.WidthDeg * 0.5f));
+}
+
+bool FRadarSectorTest::Contains(const FVector& Location) const
+{
+    if (Location.Z < MinHeight || Location.Z > MaxHeight)
+        return false;
+
+    const FVector2D ToMissile = FVector2D(Location) - Origin2D;
+    const float DistanceSquared = ToMissile.SizeSquared();
+    if (DistanceSquared > RadiusSquared)
+        return false;
+
+    // Ракета прямо над радаром: азимут 0, как у Atan2(0, 0) в исходной проверке сектора
+    if (DistanceSquared <= KINDA_SMALL_NUMBER)
+        return Axis.X >= CosHalfWidth;
+
+    return FVector2D::DotProduct(ToMissile, Axis) >= CosHalfWidth * FMath::Sqrt(DistanceSquared);
+}
+
+void UMissileSpatialSubsystem::QuerySector(const FRadarSectorQuery& Query, TArray<AMissleActor*>& OutMissiles) const
+{
+    const FRadarSectorTest Sector(Query);
+    const FVector2D Origin2D(Query.Origin);
+
+    ForEachInRect(Origin2D - Query.Radius, Origin2D + Query.Radius, [&](const FCellEntry& Entry)
+    {
+        if (Sector.Contains(Entry.Location))
+        {
+            OutMissiles.Add(Entry.Missile);
+        }
+    });
+}
+
+void UMissileSpatialSubsystem::GetCellsInRadius(const FVector& Center, float Radius, TArray<FIntPoint>& OutCells) const
+{
+    const FVector2D Center2D(Center);
+    const FIntPoint MinCell = GetCell(FVector(Center2D - Radius, 0.0f));
+    const FIntPoint MaxCell = GetCell(FVector(Center2D + Radius, 0.0f));
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            OutCells.Add(FIntPoint(X, Y));
+        }
+    }
+}
+
+bool UMissileSpatialSubsystem::GetMissileLocation(AMissleActor* Missile, FVector& OutLocation) const
+{
+    const FCellRef* Ref = MissileCells.Find(Missile);
+    if (!Ref)
+        return false;
+
+    OutLocation = Cells.FindChecked(Ref->Cell)[Ref->Slot].Location;
+    return true;
+}
@@ -0,0 +1,153 @@
+#include "MissileWaveSubsystem.h"
+#include "MissleActor.h"
+#include "MelActorPoolSubsystem.h"
+#include "EngagementClockSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+static TAutoConsoleVariable<float> CVarSpawnFrameBudget(
+    TEXT("mel.Spawn.FrameBudgetMs"),
+    2.0f,
+    TEXT("Время кадра на создание в пуле акторов ожидающих пусков (мс); на время пусков не влияет"),
+    ECVF_Default);
+
+void UMissileWaveSubsystem::Deinitialize()
+{
+    PendingLaunches.Empty();
+    NumPendingByClass.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UMissileWaveSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMissileWaveSubsystem, STATGROUP_Tickables);
+}
+
+void UMissileWaveSubsystem::ScheduleWave(TSubclassOf<AMissleActor> MissileClass, const FMissileWave& Wave,
+                                         TFunctionRef<FVector()> MakeLaunchPoint, AActor* Owner, bool bPrewarm)
+{
+    if (!MissileClass || Wave.Count <= 0)
+        return;
+
+    int32& NumPending = NumPendingByClass.FindOrAdd(MissileClass);
+    NumPending += Wave.Count;
+
+    if (bPrewarm)
+    {
+        if (UMelActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMelActorPoolSubsystem>())
+        {
+            Pool->Prewarm(MissileClass, NumPending - Pool->GetNumFree(MissileClass));
+        }
+    }
+
+    FRandomStream& Random = UEngagementClockSubsystem::GetRandomStream(GetWorld());
+    const float StartTime = UEngagementClockSubsystem::GetEngagementTime(GetWorld()) + FMath::Max(Wave.StartDelay, 0.0f);
+
+    PendingLaunches.Reserve(PendingLaunches.Num() + Wave.Count);
+    float Offset = 0.0f;
+    for (int32 Index = 0; Index < Wave.Count; ++Index)
+    {
+        Offset = GetLaunchOffset(Wave, Index, Offset, Random);
+
+        FPendingLaunch Pending;
+        Pending.LaunchTime = StartTime + Offset;
+        Pending.Sequence = NextSequence++;
+        Pending.MissileClass = MissileClass;
+        Pending.Location = MakeLaunchPoint();
+        Pending.Owner = Owner;
+        PendingLaunches.HeapPush(MoveTemp(Pending));
+    }
+}
+
+float UMissileWaveSubsystem::GetLaunchOffset(const FMissileWave& Wave, int32 Index, float PreviousOffset, FRandomStream& Random) const
+{
+    if (Index == 0)
+        return 0.0f;
+
+    const float MeanInterval = FMath::Max(Wave.MeanInterval, 0.0f);
+    switch (Wave.Pattern)
+    {
+        case EMissileArrivalPattern::Uniform:
+            return Index * MeanInterval;
+
+        case EMissileArrivalPattern::Poisson:
+            // Интервалы пуассоновского потока: -ln(U) * среднее, U из (0, 1]
+            return PreviousOffset - FMath::Loge(1.0f - Random.GetFraction()) * MeanInterval;
+
+        case EMissileArrivalPattern::Salvo:
+        {
+            const int32 SalvoSize = FMath::Max(Wave.SalvoSize, 1);
+            return (Index / SalvoSize) * MeanInterval + (Index % SalvoSize) * FMath::Max(Wave.SalvoSpread, 0.0f);
+        }
+
+        case EMissileArrivalPattern::Instant:
+        default:
+            return 0.0f;
+    }
+}
+
+void UMissileWaveSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (NumPendingByClass.Num() == 0)
+        return;
+
+    UMelActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMelActorPoolSubsystem>();
+    if (!Pool)
+        return;
+
+    // Акторы ожидающих пусков создаются по одному, пока не исчерпан бюджет кадра
+    const double Deadline = FPlatformTime::Seconds() + CVarSpawnFrameBudget.GetValueOnGameThread() * 0.001;
+    for (const TPair<UClass*, int32>& Pending : NumPendingByClass)
+    {
+        int32 NumFree = Pool->GetNumFree(Pending.Key);
+        while (NumFree < Pending.Value)
+        {
+            if (FPlatformTime::Seconds() >= Deadline)
+                return;
+
+            Pool->Prewarm(Pending.Key, 1);
+
+            // Актор не создался - следующий кадр попробует снова
+            const int32 NewNumFree = Pool->GetNumFree(Pending.Key);
+            if (NewNumFree == NumFree)
+                break;
+            NumFree = NewNumFree;
+        }
+    }
+}
+
+void UMissileWaveSubsystem::LaunchDueMissiles()
+{
+    const float Now = UEngagementClockSubsystem::GetEngagementTime(GetWorld());
+    while (PendingLaunches.Num() > 0 && PendingLaunches.HeapTop().LaunchTime <= Now)
+    {
+        FPendingLaunch Pending;
+        PendingLaunches.HeapPop(Pending, EAllowShrinking::No);
+
+        int32& NumPending = NumPendingByClass.FindChecked(Pending.MissileClass);
+        if (--NumPending == 0)
+        {
+            NumPendingByClass.Remove(Pending.MissileClass);
+        }
+
+        Launch(Pending);
+    }
+}
+
+void UMissileWaveSubsystem::Launch(const FPendingLaunch& Pending)
+{
+    const FTransform Transform(Pending.Location);
+    if (UMelActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMelActorPoolSubsystem>())
+    {
+        Pool->Acquire<AMissleActor>(Pending.MissileClass, Transform, Pending.Owner.Get());
+        return;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Owner = Pending.Owner.Get();
+    GetWorld()->SpawnActor<AMissleActor>(Pending.MissileClass, Transform, SpawnParams);
+}
@@ -1,14 +1,26 @@
 #include "MissleActor.h"
+#include "MissileSpatialSubsystem.h"
+#include "MissileMovementSubsystem.h"
+#include "RadarNetworkSubsystem.h"
+#include "MelActorPoolSubsystem.h"
+#include "EngagementClockSubsystem.h"
+#include "MelSimBridge.h"
+#include "MelStats.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Components/AudioComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "DrawDebugHelpers.h"
 
+static_assert(static_cast<uint8>(EMisslePhase::Descent) == static_cast<uint8>(MelSim::EMissilePhase::Descent),
+    "EMisslePhase должен совпадать с MelSim::EMissilePhase");
+
 AMissleActor::AMissleActor()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Движение ведет UMissileMovementSubsystem, собственный тик ракете не нужен
+    PrimaryActorTick.bCanEverTick = false;
 
     Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
     RootComponent = Mesh;
@@ -30,21 +42,91 @@ AMissleActor::AMissleActor()
 
     // Устанавливаем начальную ориентацию меша (ракета направлена строго вверх)
     Mesh->SetRelativeRotation(FRotator(0.0f, 0.0f, 0.0f));
+
+    Phase = EMisslePhase::Ascending;
+    CurrentVelocity = FVector::ZeroVector;
+    MovementId = INDEX_NONE;
+    LaunchSerial = 0;
+    Significance = EMissileSignificance::High;
+    RotationUpdateInterval = 0.0f;
+    TimeSinceRotationUpdate = 0.0f;
+    bPooledIdle = false;
+    SpatialIndex = nullptr;
+    MovementSystem = nullptr;
+    RadarNetwork = nullptr;
+    EngagementClock = nullptr;
 }
 
 void AMissleActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    MovementSystem = GetWorld()->GetSubsystem<UMissileMovementSubsystem>();
+    SpatialIndex = GetWorld()->GetSubsystem<UMissileSpatialSubsystem>();
+    RadarNetwork = GetWorld()->GetSubsystem<URadarNetworkSubsystem>();
+    EngagementClock = GetWorld()->GetSubsystem<UEngagementClockSubsystem>();
+
+    if (!bPooledIdle)
+    {
+        StartFlight();
+    }
+}
+
+void AMissleActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StopFlight();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AMissleActor::OnAcquiredFromPool()
+{
+    bPooledIdle = false;
+    if (HasActorBegunPlay())
+    {
+        StartFlight();
+    }
+}
+
+void AMissleActor::OnReleasedToPool()
+{
+    bPooledIdle = true;
+    StopFlight();
+}
+
+void AMissleActor::StartFlight()
+{
+    if (IsInFlight())
+        return;
+
+    ++LaunchSerial;
+
+    MelSim::FMissileParams SimParams;
+    SimParams.TargetHeight = TargetHeight;
+    SimParams.HorizontalHeight = HorizontalHeight;
+    SimParams.HorizontalDistance = HorizontalDistance;
+    SimParams.Speed = Speed;
+    SimParams.TransitionTime = TransitionTime;
+
+    // Начальное направление строго вверх, цель в начале координат
+    const MelSim::FMissileState SimState = MelSim::MakeMissile(MelSim::ToSim(GetActorLocation()), MelSim::FVec3(0.0f, 0.0f, 0.0f), SimParams);
+    if (EngagementClock)
+    {
+        EngagementClock->RecordMissile(GetActorLocation(), FVector::ZeroVector);
+    }
     Phase = EMisslePhase::Ascending;
-    CurrentTransitionTime = 0.0f;
-    // Устанавливаем начальное направление строго вверх
-    InitialDirection = FVector(0.0f, 0.0f, 1.0f);
-    TargetPoint = FVector(0.0f, 0.0f, 0.0f);
-    CurrentVelocity = InitialDirection * Speed;
+    CurrentVelocity = MelSim::ToUE(SimState.Velocity);
     
     if (MovementComponent)
     {
+        // Компонент только хранит скорость для радаров и ПВО, позицию задает пакетное движение
         MovementComponent->Velocity = CurrentVelocity;
+        MovementComponent->SetComponentTickEnabled(false);
+    }
+
+    if (MovementSystem)
+    {
+        MovementId = MovementSystem->RegisterMissile(this, SimState, SimParams);
     }
 
     // Воспроизводим звук взлёта
@@ -56,115 +138,145 @@ void AMissleActor::BeginPlay()
         LaunchSoundComponent->SetFloatParameter(FName("Distance"), 10000.0f);
         LaunchSoundComponent->SetFloatParameter(FName("Volume"), 2.0f);
     }
+
+    if (SpatialIndex)
+    {
+        SpatialIndex->RegisterMissile(this);
+    }
 }
 
-void AMissleActor::Tick(float DeltaTime)
+void AMissleActor::StopFlight()
 {
-    Super::Tick(DeltaTime);
+    if (MovementSystem && MovementId != INDEX_NONE)
+    {
+        MovementSystem->UnregisterMissile(MovementId);
+    }
+    MovementId = INDEX_NONE;
 
-    switch (Phase)
+    if (SpatialIndex)
     {
-        case EMisslePhase::Ascending:
-            CurrentVelocity = FVector(0.0f, 0.0f, Speed);
-            if (GetActorLocation().Z >= TargetHeight)
-            {
-                Phase = EMisslePhase::Transition;
-                CurrentTransitionTime = 0.0f;
-                // Calculate direction to target when starting transition
-                FVector ToTarget = (TargetPoint - GetActorLocation()).GetSafeNormal();
-                TargetDirection = ToTarget;
-            }
-            break;
+        SpatialIndex->UnregisterMissile(this);
+    }
 
-        case EMisslePhase::Transition:
-            CurrentTransitionTime += DeltaTime;
-            if (CurrentTransitionTime >= TransitionTime)
-            {
-                Phase = EMisslePhase::Horizontal;
-                // Сохраняем точки начала и конца горизонтального полета
-                HorizontalStartPoint = GetActorLocation();
-                // Вычисляем точку окончания горизонтального полета
-                FVector DirectionToTarget = (TargetPoint - HorizontalStartPoint).GetSafeNormal();
-                HorizontalEndPoint = HorizontalStartPoint + DirectionToTarget * HorizontalDistance;
-                HorizontalEndPoint.Z = HorizontalHeight; // Устанавливаем высоту горизонтального полета
-            }
-            else
-            {
-                float Alpha = FMath::SmoothStep(0.0f, 1.0f, CurrentTransitionTime / TransitionTime);
-                // Smoothly interpolate from vertical to horizontal direction
-                FVector CurrentDirection = FMath::Lerp(FVector(0.0f, 0.0f, 1.0f), TargetDirection, Alpha);
-                CurrentVelocity = CurrentDirection * Speed;
-            }
-            break;
-
-        case EMisslePhase::Horizontal:
-            // Летим горизонтально к точке HorizontalEndPoint
-            FVector ToHorizontalEnd = (HorizontalEndPoint - GetActorLocation()).GetSafeNormal();
-            CurrentVelocity = ToHorizontalEnd * Speed;
-            
-            // Проверяем, достигли ли мы точки окончания горизонтального полета
-            if (FVector::Dist(GetActorLocation(), HorizontalEndPoint) < 100.0f)
-            {
-                Phase = EMisslePhase::Descent;
-            }
-            break;
+    // Тот же актор вернется из пула новой ракетой - радары не должны продолжать старый трек
+    if (RadarNetwork)
+    {
+        RadarNetwork->ForgetMissile(this);
+    }
 
-        case EMisslePhase::Descent:
-            // Calculate direction to target
-            FVector ToTarget = (TargetPoint - GetActorLocation()).GetSafeNormal();
-            CurrentVelocity = ToTarget * Speed;
-            break;
+    if (LaunchSoundComponent)
+    {
+        LaunchSoundComponent->Stop();
     }
 
-    // Обновляем скорость в компоненте движения
+    Phase = EMisslePhase::Ascending;
+    CurrentVelocity = FVector::ZeroVector;
     if (MovementComponent)
     {
-        MovementComponent->Velocity = CurrentVelocity;
+        MovementComponent->Velocity = FVector::ZeroVector;
     }
 
-    // Обновляем позицию
-    FVector NewLocation = GetActorLocation() + CurrentVelocity * DeltaTime;
-    SetActorLocation(NewLocation);
+    // Из пула ракета выходит с полной детализацией, пока подсистема значимости ее не оценит
+    SetSignificance(EMissileSignificance::High);
+    TimeSinceRotationUpdate = 0.0f;
+}
 
-    // Обновляем вращение
-    UpdateRotation(DeltaTime);
+void AMissleActor::SetSignificance(EMissileSignificance NewSignificance)
+{
+    if (NewSignificance == Significance)
+        return;
 
-    // Проверяем столкновение
-    if (CheckTargetCollision())
+    Significance = NewSignificance;
+    const bool bLow = Significance == EMissileSignificance::Low;
+
+    switch (Significance)
+    {
+        case EMissileSignificance::High:   RotationUpdateInterval = 0.0f; break;
+        case EMissileSignificance::Medium: RotationUpdateInterval = MediumRotationInterval; break;
+        case EMissileSignificance::Low:    RotationUpdateInterval = LowRotationInterval; break;
+    }
+
+    if (Mesh)
+    {
+        // 0 - автоматический выбор LOD, N - принудительно LOD N-1 (младший)
+        const int32 NumLODs = Mesh->GetStaticMesh() ? Mesh->GetStaticMesh()->GetNumLODs() : 0;
+        Mesh->SetForcedLodModel(bLow ? NumLODs : 0);
+        Mesh->SetCastShadow(!bLow);
+    }
+
+    // Звук пуска далекой ракеты не слышен, а голос занимает микшер
+    if (bLow && LaunchSoundComponent && LaunchSoundComponent->IsPlaying())
     {
-        Explode();
+        LaunchSoundComponent->Stop();
     }
 }
 
-void AMissleActor::UpdateRotation(float DeltaTime)
+bool AMissleActor::ApplyBatchedMovement(const FVector& NewLocation, const FVector& NewVelocity, EMisslePhase NewPhase, float DeltaTime)
 {
-    FRotator TargetRotation;
-    
-    if (Phase == EMisslePhase::Ascending)
+    Phase = NewPhase;
+    CurrentVelocity = NewVelocity;
+
+    // Обновляем скорость в компоненте движения
+    if (MovementComponent)
     {
-        // При взлете ракета направлена основанием вниз
-        TargetRotation = FRotator(-90.0f, 0.0f, 0.0f);
+        MovementComponent->Velocity = CurrentVelocity;
+    }
+
+    // Позиция каждый шаг (по ней работают радары и проверка столкновения), поворот - с частотой
+    // по значимости; пропущенное время догоняется одним RInterpTo
+    TimeSinceRotationUpdate += DeltaTime;
+    if (TimeSinceRotationUpdate >= RotationUpdateInterval)
+    {
+        SetActorLocationAndRotation(NewLocation, CalculateRotation(TimeSinceRotationUpdate));
+        TimeSinceRotationUpdate = 0.0f;
     }
     else
     {
-        // При полете к цели ракета должна быть направлена носом вперед
-        // Для этого добавляем 180 градусов к повороту, чтобы развернуть ракету
-        TargetRotation = CurrentVelocity.Rotation() + FRotator(180.0f, 0.0f, 0.0f);
+        SetActorLocation(NewLocation);
     }
-    
+
+    // Обновляем ячейку ракеты в пространственном индексе
+    if (SpatialIndex)
+    {
+        SpatialIndex->UpdateMissile(this);
+    }
+
+    // Проверяем столкновение
+    return CheckTargetCollision();
+}
+
+FRotator AMissleActor::GetTargetRotation() const
+{
+    if (GetPhase() == EMisslePhase::Ascending)
+    {
+        // При взлете ракета направлена основанием вниз
+        return FRotator(-90.0f, 0.0f, 0.0f);
+    }
+
+    // При полете к цели ракета должна быть направлена носом вперед
+    // Для этого добавляем 180 градусов к повороту, чтобы развернуть ракету
+    return CurrentVelocity.Rotation() + FRotator(180.0f, 0.0f, 0.0f);
+}
+
+FRotator AMissleActor::CalculateRotation(float DeltaTime) const
+{
     FRotator CurrentRotation = GetActorRotation();
-    FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, RotationSpeed);
-    SetActorRotation(NewRotation);
+    return FMath::RInterpTo(CurrentRotation, GetTargetRotation(), DeltaTime, RotationSpeed);
 }
 
 bool AMissleActor::CheckTargetCollision()
 {
-    if (Phase != EMisslePhase::Descent)
+    if (GetPhase() != EMisslePhase::Descent)
         return false;
 
+    // Только счетчик stat: область Insights на каждую снижающуюся ракету засорила бы трассу
+    SCOPE_CYCLE_COUNTER(STAT_MelMissileCollision);
+
+    // Луч по направлению носа из скорости, а не по отображаемому повороту:
+    // частота поворота зависит от значимости, исход полета не должен
     FHitResult HitResult;
     FVector Start = GetActorLocation();
-    FVector End = Start + GetActorForwardVector() * 100.0f;
+    FVector End = Start + GetTargetRotation().Vector() * 100.0f;
 
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(this);
@@ -179,6 +291,11 @@ bool AMissleActor::CheckTargetCollision()
 
 void AMissleActor::Explode()
 {
+    if (EngagementClock)
+    {
+        EngagementClock->RecordImpact();
+    }
+
     if (ExplosionEffect)
     {
         UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosionEffect, GetActorLocation());
@@ -208,6 +325,6 @@ void AMissleActor::Explode()
         }
     }
 
-    Destroy();
+    UMelActorPoolSubsystem::ReleaseOrDestroy(this);
 }
 
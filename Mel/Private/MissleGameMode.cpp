@@ -2,6 +2,8 @@
 
 #include "MissleGameMode.h"
 #include "MissleActor.h"
+#include "MissileWaveSubsystem.h"
+#include "EngagementClockSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 
@@ -9,32 +11,28 @@ void AMissleGameMode::BeginPlay()
 {
     Super::BeginPlay();
 
-    //   
-    for (int i = 0; i < 10; ++i)
+    //     ,        
+    if (UMissileWaveSubsystem* WaveScheduler = GetWorld()->GetSubsystem<UMissileWaveSubsystem>())
     {
-        SpawnMissle();
+        FMissileWave Wave;
+        Wave.Count = 10;
+        Wave.Pattern = EMissileArrivalPattern::Instant;
+        WaveScheduler->ScheduleWave(MissleClass, Wave, [this]() { return GetRandomEdgePosition(MapHalfSize); }, this);
     }
 }
 
-void AMissleGameMode::SpawnMissle()
-{
-    if (!MissleClass) return;
-
-    FVector SpawnLocation = GetRandomEdgePosition(MapHalfSize);
-    FActorSpawnParameters Params;
-    GetWorld()->SpawnActor<AMissleActor>(MissleClass, SpawnLocation, FRotator::ZeroRotator, Params);
-}
-
 FVector AMissleGameMode::GetRandomEdgePosition(float Distance)
 {
-    int32 Edge = FMath::RandRange(0, 3);
+    //   :    ,      
+    FRandomStream& Random = UEngagementClockSubsystem::GetRandomStream(GetWorld());
+    int32 Edge = Random.RandRange(0, 3);
     float X = 0.f, Y = 0.f;
     switch (Edge)
     {
-    case 0: X = Distance; Y = FMath::RandRange(-Distance, Distance); break;  // Right
-    case 1: X = -Distance; Y = FMath::RandRange(-Distance, Distance); break; // Left
-    case 2: X = FMath::RandRange(-Distance, Distance); Y = Distance; break;  // Top
-    case 3: X = FMath::RandRange(-Distance, Distance); Y = -Distance; break; // Bottom
+    case 0: X = Distance; Y = Random.FRandRange(-Distance, Distance); break;  // Right
+    case 1: X = -Distance; Y = Random.FRandRange(-Distance, Distance); break; // Left
+    case 2: X = Random.FRandRange(-Distance, Distance); Y = Distance; break;  // Top
+    case 3: X = Random.FRandRange(-Distance, Distance); Y = -Distance; break; // Bottom
     }
 
     return FVector(X, Y, 100.f); // Z 
@@ -1,5 +1,7 @@
 #include "MissleSpawner.h"
 #include "MissleActor.h"
+#include "MelActorPoolSubsystem.h"
+#include "EngagementClockSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 
@@ -12,9 +14,22 @@ void AMissleSpawner::BeginPlay()
 {
     Super::BeginPlay();
 
-    for (int i = 0; i < MissleCount; ++i)
+    UMissileWaveSubsystem* WaveScheduler = GetWorld()->GetSubsystem<UMissileWaveSubsystem>();
+    if (!WaveScheduler)
+        return;
+
+    // Пуски идут по времени боя через планировщик волн, а не все в одном кадре
+    TArray<FMissileWave> ScheduledWaves = Waves;
+    if (ScheduledWaves.Num() == 0)
+    {
+        FMissileWave& Wave = ScheduledWaves.AddDefaulted_GetRef();
+        Wave.Count = MissleCount;
+        Wave.Pattern = EMissileArrivalPattern::Instant;
+    }
+
+    for (const FMissileWave& Wave : ScheduledWaves)
     {
-        SpawnMissle();
+        WaveScheduler->ScheduleWave(MissleClass, Wave, [this]() { return GetRandomEdgePosition(MapHalfSize); }, this, bPrewarmWaves);
     }
 }
 
@@ -23,19 +38,27 @@ void AMissleSpawner::SpawnMissle()
     if (!MissleClass) return;
 
     FVector SpawnLocation = GetRandomEdgePosition(MapHalfSize);
-    GetWorld()->SpawnActor<AMissleActor>(MissleClass, SpawnLocation, FRotator::ZeroRotator);
+    if (UMelActorPoolSubsystem* Pool = GetWorld()->GetSubsystem<UMelActorPoolSubsystem>())
+    {
+        Pool->Acquire<AMissleActor>(MissleClass, FTransform(SpawnLocation), this);
+    }
+    else
+    {
+        GetWorld()->SpawnActor<AMissleActor>(MissleClass, SpawnLocation, FRotator::ZeroRotator);
+    }
 }
 
 FVector AMissleSpawner::GetRandomEdgePosition(float Distance)
 {
-    int32 Edge = FMath::RandRange(0, 3);
+    FRandomStream& Random = UEngagementClockSubsystem::GetRandomStream(GetWorld());
+    int32 Edge = Random.RandRange(0, 3);
     float X = 0.f, Y = 0.f;
     switch (Edge)
     {
-    case 0: X = Distance; Y = FMath::RandRange(-Distance, Distance); break;
-    case 1: X = -Distance; Y = FMath::RandRange(-Distance, Distance); break;
-    case 2: Y = Distance; X = FMath::RandRange(-Distance, Distance); break;
-    case 3: Y = -Distance; X = FMath::RandRange(-Distance, Distance); break;
+    case 0: X = Distance; Y = Random.FRandRange(-Distance, Distance); break;
+    case 1: X = -Distance; Y = Random.FRandRange(-Distance, Distance); break;
+    case 2: Y = Distance; X = Random.FRandRange(-Distance, Distance); break;
+    case 3: Y = -Distance; X = Random.FRandRange(-Distance, Distance); break;
     }
 
     return FVector(X, Y, 100.f);
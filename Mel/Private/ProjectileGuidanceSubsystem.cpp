@@ -0,0 +1,202 @@
+#include "ProjectileGuidanceSubsystem.h"
+#include "AAProjectileActor.h"
+#include "MissleActor.h"
+#include "MissileSpatialSubsystem.h"
+#include "MissileMovementSubsystem.h"
+#include "MelActorPoolSubsystem.h"
+#include "EngagementClockSubsystem.h"
+#include "MelDebug.h"
+#include "MelSimBridge.h"
+#include "MelStats.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarProjectileParallelGuidance(
+    TEXT("mel.Projectile.ParallelGuidance"),
+    1,
+    TEXT("1 - наведение снарядов считается на рабочих потоках, 0 - на игровом потоке"),
+    ECVF_Default);
+
+// Снарядов на одну задачу рабочего потока: шаг снаряда дешевый, мелкие задачи не окупаются
+static constexpr int32 ProjectilesPerTask = 64;
+
+void UProjectileGuidanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    SpatialIndex = Collection.InitializeDependency<UMissileSpatialSubsystem>();
+    MovementSystem = Collection.InitializeDependency<UMissileMovementSubsystem>();
+}
+
+void UProjectileGuidanceSubsystem::Deinitialize()
+{
+    Batch = MelSim::FProjectileBatch();
+    Projectiles.Reset();
+    Targets.Reset();
+    MaxFlightTimes.Reset();
+    FinishedProjectiles.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId UProjectileGuidanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileGuidanceSubsystem, STATGROUP_Tickables);
+}
+
+int32 UProjectileGuidanceSubsystem::RegisterProjectile(AAAProjectileActor* Projectile, const MelSim::FProjectileState& State, AMissleActor* Target)
+{
+    const int32 ProjectileId = Batch.Add(State);
+    Projectiles.Add(Projectile);
+
+    FProjectileTarget& NewTarget = Targets.AddDefaulted_GetRef();
+    NewTarget.Missile = Target;
+    NewTarget.LaunchSerial = Target ? Target->GetLaunchSerial() : 0;
+
+    MaxFlightTimes.Add(Projectile->GetMaxFlightTime());
+    check(Projectiles.Num() == Batch.Num());
+    return ProjectileId;
+}
+
+void UProjectileGuidanceSubsystem::UnregisterProjectile(int32 ProjectileId)
+{
+    const int32 Index = Batch.GetIndex(ProjectileId);
+    if (Index == INDEX_NONE)
+        return;
+
+    // Пакет переносит последний элемент на место удаленного - массивы акторов повторяют это
+    Batch.Remove(ProjectileId);
+    Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    MaxFlightTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+bool UProjectileGuidanceSubsystem::IsTargetAlive(const FProjectileTarget& Target)
+{
+    return Target.Missile && Target.Missile->IsValidLowLevel() && Target.Missile->IsInFlight() &&
+           Target.Missile->GetLaunchSerial() == Target.LaunchSerial;
+}
+
+void UProjectileGuidanceSubsystem::VisitTargetedProjectiles(TFunctionRef<void(AMissleActor*, const MelSim::FProjectileState&)> Visitor) const
+{
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        if (IsTargetAlive(Targets[Index]))
+        {
+            Visitor(Targets[Index].Missile, Batch.GetState(Index));
+        }
+    }
+}
+
+void UProjectileGuidanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SET_DWORD_STAT(STAT_MelActiveProjectiles, Batch.Num());
+}
+
+void UProjectileGuidanceSubsystem::StepProjectiles(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MelProjectileStep);
+
+    const int32 NumProjectiles = Batch.Num();
+    if (NumProjectiles == 0)
+        return;
+
+    // Снимок целей: акторы ракет читаются только на игровом потоке. Прямой полет цели не требует.
+    for (int32 Index = 0; Index < NumProjectiles; ++Index)
+    {
+        const FProjectileTarget& Target = Targets[Index];
+        if (Batch.GetState(Index).bIsHoming && IsTargetAlive(Target))
+        {
+            Batch.SetTarget(Index, MelSim::ToSim(Target.Missile->GetActorLocation()), MelSim::ToSim(Target.Missile->GetCurrentVelocity()));
+        }
+        else
+        {
+            Batch.ClearTarget(Index);
+        }
+    }
+
+    // Наведение: диапазоны пакета независимы
+    const int32 NumTasks = FMath::DivideAndRoundUp(NumProjectiles, ProjectilesPerTask);
+    const bool bSingleThread = CVarProjectileParallelGuidance.GetValueOnGameThread() == 0 || NumTasks == 1;
+    ParallelFor(NumTasks, [this, NumProjectiles, DeltaTime](int32 TaskIndex)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_MelProjectileGuidance);
+        const int32 Begin = TaskIndex * ProjectilesPerTask;
+        Batch.StepRange(Begin, FMath::Min(Begin + ProjectilesPerTask, NumProjectiles), DeltaTime);
+    }, bSingleThread);
+
+    // Ракета за шаг проходит не больше MissileStep: запрос по индексу покрывает все ракеты,
+    // которые могли сблизиться с отрезком снаряда
+    const float MissileStep = (MovementSystem ? MovementSystem->GetMaxMissileSpeed() : 0.0f) * DeltaTime;
+
+    // Один проход записи: трансформ, попадание, время полета, подрыв по близости
+    SCOPE_CYCLE_COUNTER(STAT_MelProjectileCollision);
+    for (int32 Index = 0; Index < NumProjectiles; ++Index)
+    {
+        AAAProjectileActor* Projectile = Projectiles[Index];
+        const MelSim::FProjectileState& State = Batch.GetState(Index);
+        Projectile->ApplyBatchedGuidance(MelSim::ToUE(State.Position), MelSim::ToUE(State.Forward));
+
+        if (Batch.GetResult(Index) == MelSim::EProjectileResult::HitTarget)
+        {
+            FinishedProjectiles.Add({ Projectile, Targets[Index], false });
+            continue;
+        }
+
+        if (State.FlightTime > MaxFlightTimes[Index])
+        {
+            FinishedProjectiles.Add({ Projectile, FProjectileTarget(), false });
+            continue;
+        }
+
+        if (!SpatialIndex)
+            continue;
+
+        const MelSim::FVec3 SweepCenter = MelSim::FVec3::Lerp(State.PreviousPosition, State.Position, 0.5f);
+        const float SweepRadius = MelSim::ProjectileProximityRadius + 0.5f * MelSim::FVec3::Dist(State.PreviousPosition, State.Position) + MissileStep;
+
+        FoundMissiles.Reset();
+        SpatialIndex->QueryRadius(MelSim::ToUE(SweepCenter), SweepRadius, FoundMissiles);
+        for (AMissleActor* Missile : FoundMissiles)
+        {
+            if (Missile && Missile->IsValidLowLevel() &&
+                MelSim::SweptProximity(State, MelSim::ToSim(Missile->GetActorLocation()), MelSim::ToSim(Missile->GetCurrentVelocity()),
+                                       DeltaTime, MelSim::ProjectileProximityRadius))
+            {
+                FinishedProjectiles.Add({ Projectile, { Missile, Missile->GetLaunchSerial() }, true });
+                break;
+            }
+        }
+    }
+
+    // Возврат в пул удаляет снаряды и ракеты из пакетов, поэтому выполняется после прохода.
+    // Ракету, уже сбитую другим снарядом на этом шаге, второй снаряд не поражает и летит дальше.
+    // Часы боя зависят от этой подсистемы, поэтому берутся из мира здесь, а не в Initialize.
+    UEngagementClockSubsystem* EngagementClock = GetWorld()->GetSubsystem<UEngagementClockSubsystem>();
+    for (const FFinishedProjectile& Finished : FinishedProjectiles)
+    {
+        if (Finished.Hit.Missile)
+        {
+            if (!IsTargetAlive(Finished.Hit))
+                continue;
+
+            if (Finished.bProximity)
+            {
+                MEL_DEBUG(Info, Finished.Projectile, 2.0f, FColor::Red, TEXT("ПВО: Попадание по близости!"));
+            }
+            else
+            {
+                MEL_DEBUG(Info, Finished.Projectile, 2.0f, FColor::Red, TEXT("ПВО: Попадание!"));
+            }
+            INC_DWORD_STAT(STAT_MelHits);
+            if (EngagementClock)
+            {
+                EngagementClock->RecordIntercept();
+            }
+            UMelActorPoolSubsystem::ReleaseOrDestroy(Finished.Hit.Missile);
+        }
+        UMelActorPoolSubsystem::ReleaseOrDestroy(Finished.Projectile);
+    }
+    FinishedProjectiles.Reset();
+}
@@ -1,15 +1,27 @@
 #include "RadarActor.h"
 #include "MissleActor.h"
+#include "MissileSpatialSubsystem.h"
+#include "MissileMovementSubsystem.h"
+#include "RadarNetworkSubsystem.h"
+#include "EngagementClockSubsystem.h"
+#include "MelDebug.h"
+#include "MelStats.h"
+#include "MelSimBridge.h"
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/Engine.h"
 
 ARadarActor::ARadarActor()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Тик нужен только отладочной отрисовке луча
+    PrimaryActorTick.bCanEverTick = MEL_DEBUG_ENABLED;
+    PrimaryActorTick.TickGroup = TG_PostPhysics;
     
     AudioComponent = CreateDefaultSubobject<UAudioComponent>(TEXT("AudioComponent"));
     RootComponent = AudioComponent;
+    SpatialIndex = nullptr;
+    RadarNetwork = nullptr;
+    MovementSystem = nullptr;
 }
 
 void ARadarActor::BeginPlay()
@@ -17,29 +29,64 @@ void ARadarActor::BeginPlay()
     Super::BeginPlay();
     CurrentScanAngle = 0.0f;
     TimeSinceLastScan = 0.0f;
-}
+    SpatialIndex = GetWorld()->GetSubsystem<UMissileSpatialSubsystem>();
+    MovementSystem = GetWorld()->GetSubsystem<UMissileMovementSubsystem>();
+    RadarNetwork = GetWorld()->GetSubsystem<URadarNetworkSubsystem>();
+    if (RadarNetwork)
+    {
+        RadarNetwork->RegisterRadar(this);
+    }
 
-void ARadarActor::Tick(float DeltaTime)
-{
-    Super::Tick(DeltaTime);
+    if (UEngagementClockSubsystem* EngagementClock = GetWorld()->GetSubsystem<UEngagementClockSubsystem>())
+    {
+        EngagementClock->RecordRadar(GetActorLocation());
 
-    // Update scan angle
-    CurrentScanAngle += ScanSpeed * DeltaTime;
-    if (CurrentScanAngle >= 360.0f)
+        // Луч рисуется после шага радара в этом кадре
+        EngagementClock->AddStepPrerequisite(this);
+    }
+
+    SimParams.ScanRadius = ScanRadius;
+    SimParams.ScanSpeed = ScanSpeed;
+    SimParams.ScanInterval = ScanInterval;
+    SimParams.ScanSectorWidth = ScanSectorWidth;
+    SimParams.MinDetectionHeight = MinDetectionHeight;
+    SimParams.MaxDetectionHeight = MaxDetectionHeight;
+    SimParams.PredictionTime = PredictionTime;
+    SimParams.ThreatDistanceWeight = ThreatDistanceWeight;
+    SimParams.ThreatSpeedWeight = ThreatSpeedWeight;
+    SimParams.ThreatHeightWeight = ThreatHeightWeight;
+    SimParams.bSweptScan = bSweptScan;
+    SimParams.Filter = MelSim::MakeTrackFilterParams(TrackFilterDiscount);
+    SimParams.FullDetailRange = FullDetailRange;
+    SimParams.FullDetailThreat = FullDetailThreat;
+    SimParams.FarTrackUpdateInterval = FarTrackUpdateInterval;
+    SweepClock = MelSim::FSweepClock();
+
+    if (SpatialIndex)
     {
-        CurrentScanAngle -= 360.0f;
+        AzimuthIndex.Initialize(*SpatialIndex, GetActorLocation(), ScanRadius, MaxTargetSpeed);
     }
+}
 
-    // Perform scan at intervals
-    TimeSinceLastScan += DeltaTime;
-    if (TimeSinceLastScan >= ScanInterval)
+void ARadarActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (RadarNetwork)
     {
-        PerformScan();
-        TimeSinceLastScan = 0.0f;
+        RadarNetwork->UnregisterRadar(this);
     }
 
-    // Cleanup old detections
-    CleanupOldDetections();
+    Super::EndPlay(EndPlayReason);
+}
+
+void ARadarActor::ForgetMissile(AMissleActor* Missile)
+{
+    Tracks.Remove(Tracks.FindId(Missile));
+    AzimuthIndex.Remove(Missile);
+}
+
+void ARadarActor::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
 
     // Draw debug visualization of radar sweep
     FVector Start = GetActorLocation();
@@ -57,148 +104,202 @@ void ARadarActor::Tick(float DeltaTime)
     DrawDebugLine(GetWorld(), Start, SectorStart2, FColor::Yellow, false, -1.0f, 0, 1.0f);
 }
 
-void ARadarActor::PerformScan()
+void ARadarActor::StepEngagement(float DeltaTime)
 {
-    TArray<AActor*> FoundActors;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AMissleActor::StaticClass(), FoundActors);
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarStep);
 
-    for (AActor* Actor : FoundActors)
+    // Азимутальные корзины обновляются понемногу каждый кадр
+    if (SpatialIndex)
     {
-        if (!Actor || !Actor->IsValidLowLevel())
-            continue;
-
-        FVector MissileLocation = Actor->GetActorLocation();
-        
-        // Проверяем высоту ракеты
-        if (!IsMissileInHeightRange(MissileLocation))
-            continue;
+        SCOPE_CYCLE_COUNTER(STAT_MelRadarAzimuthRefresh);
+        AzimuthIndex.Refresh(*SpatialIndex, DeltaTime);
+    }
 
-        // Проверяем, находится ли ракета в секторе сканирования
-        if (IsMissileInScanSector(MissileLocation))
+    if (bSweptScan)
+    {
+        // Под-скан на каждый шаг ScanInterval по всему сектору, пройденному лучом;
+        // длинный кадр догоняется несколькими под-сканами
+        MelSim::FSweepInterval Intervals[MelSim::MaxSubScansPerStep];
+        const int32 NumIntervals = MelSim::AdvanceSweep(SimParams, SweepClock, DeltaTime, Intervals);
+        for (int32 i = 0; i < NumIntervals; ++i)
         {
-            UpdateMissileData(Actor);
+            PendingScanQueries.Add(MakeScanQuery(Intervals[i].CenterAngle, Intervals[i].Width, Intervals[i].Age));
         }
+        CurrentScanAngle = MelSim::GetBeamAngle(SimParams, SweepClock);
     }
-
-    // Сортируем ракеты по уровню угрозы
-    SortMissilesByThreat();
-
-    // Выводим информацию о наиболее опасных ракетах
-    for (int32 i = 0; i < FMath::Min(DetectedMissiles.Num(), 3); i++)
+    else
     {
-        const FMissileData& MissileData = DetectedMissiles[i];
-        if (MissileData.Missile && MissileData.Missile->IsValidLowLevel())
+        // Update scan angle
+        CurrentScanAngle = MelSim::AdvanceScanAngle(CurrentScanAngle, ScanSpeed, DeltaTime);
+
+        // Perform scan at intervals
+        TimeSinceLastScan += DeltaTime;
+        if (TimeSinceLastScan >= ScanInterval)
         {
-            FString Message = FString::Printf(TEXT("РАДАР #%d: Ракета обнаружена! Угроза: %.2f | Координаты: X=%.0f, Y=%.0f, Z=%.0f | Скорость: %.0f м/с"),
-                i + 1,
-                MissileData.ThreatLevel,
-                MissileData.Position.X,
-                MissileData.Position.Y,
-                MissileData.Position.Z,
-                MissileData.Velocity.Size());
-            
-            FColor MessageColor = (i == 0) ? FColor::Red : (i == 1) ? FColor::Orange : FColor::Yellow;
-            GEngine->AddOnScreenDebugMessage(-1, 0.1f, MessageColor, Message);
+            PendingScanQueries.Add(MakeScanQuery(CurrentScanAngle, ScanSectorWidth, 0.0f));
+            TimeSinceLastScan = 0.0f;
         }
     }
+
+    // В параллельном режиме сканы выполнит сеть радаров вместе с остальными радарами
+    if (PendingScanQueries.Num() > 0 && !(RadarNetwork && URadarNetworkSubsystem::IsParallelScanEnabled()))
+    {
+        PerformScan();
+    }
 }
 
-bool ARadarActor::IsMissileInScanSector(const FVector& MissileLocation)
+void ARadarActor::PerformScan()
 {
-    FVector DirectionToMissile = MissileLocation - GetActorLocation();
-    DirectionToMissile.Z = 0.0f;
-    float Distance = DirectionToMissile.Size();
-    
-    if (Distance > ScanRadius)
-        return false;
+    TArray<AMissleActor*> FoundMissiles;
+    RunPendingScans(UEngagementClockSubsystem::GetEngagementTime(GetWorld()), FoundMissiles);
+    FinishScan();
+}
 
-    DirectionToMissile.Normalize();
+void ARadarActor::RunPendingScans(float CurrentTime, TArray<AMissleActor*>& Candidates)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarScan);
 
-    float MissileAngle = FMath::RadiansToDegrees(FMath::Atan2(DirectionToMissile.Y, DirectionToMissile.X));
-    if (MissileAngle < 0.0f)
+    if (SpatialIndex)
     {
-        MissileAngle += 360.0f;
+        for (const FRadarSectorQuery& Query : PendingScanQueries)
+        {
+            // Проверяются только ракеты из азимутальных корзин под лучом
+            Candidates.Reset();
+            AzimuthIndex.QuerySector(*SpatialIndex, Query, Candidates);
+            ProcessScanCandidates(Candidates, CurrentTime);
+        }
     }
+    CompletePendingScans(CurrentTime);
+}
 
-    float AngleDifference = FMath::Abs(MissileAngle - CurrentScanAngle);
-    if (AngleDifference > 180.0f)
+void ARadarActor::CompletePendingScans(float CurrentTime)
+{
+    INC_DWORD_STAT_BY(STAT_MelRadarScans, PendingScanQueries.Num());
+
+    if (SpatialIndex)
     {
-        AngleDifference = 360.0f - AngleDifference;
+        ApplyMeasurements(CurrentTime);
     }
-
-    return AngleDifference <= ScanSectorWidth * 0.5f;
+    PendingScanQueries.Reset();
 }
 
-bool ARadarActor::IsMissileInHeightRange(const FVector& MissileLocation)
+FRadarSectorQuery ARadarActor::MakeScanQuery(float CenterAngleDeg, float WidthDeg, float Age) const
 {
-    return MissileLocation.Z >= MinDetectionHeight && MissileLocation.Z <= MaxDetectionHeight;
+    FRadarSectorQuery Query;
+    Query.Origin = GetActorLocation();
+    Query.Radius = ScanRadius;
+    Query.CenterAngleDeg = CenterAngleDeg;
+    Query.WidthDeg = WidthDeg;
+    Query.MinHeight = MinDetectionHeight;
+    Query.MaxHeight = MaxDetectionHeight;
+    Query.Age = Age;
+    return Query;
 }
 
-void ARadarActor::UpdateMissileData(AActor* Missile)
+void ARadarActor::ProcessScanCandidates(const TArray<AMissleActor*>& Candidates, float CurrentTime)
 {
-    if (!Missile || !Missile->IsValidLowLevel())
-        return;
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarUpdateMissileData);
 
-    FVector CurrentPosition = Missile->GetActorLocation();
-    FVector CurrentVelocity = FVector::ZeroVector;
+    for (AMissleActor* Missile : Candidates)
+    {
+        UpdateMissileData(Missile, CurrentTime);
+    }
+}
+
+void ARadarActor::FinishScan()
+{
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarReport);
 
-    UMovementComponent* MovementComp = Missile->FindComponentByClass<UMovementComponent>();
-    if (MovementComp)
+    // Новые обнаружения могут подтвердить трек в слитой картине сети
+    if (PendingEvents.Num() > 0 && RadarNetwork)
     {
-        CurrentVelocity = MovementComp->Velocity;
+        RadarNetwork->NotifyDetections();
     }
 
-    int32 ExistingIndex = -1;
-    for (int32 i = 0; i < DetectedMissiles.Num(); i++)
+    for (const FDetectionEvent& Event : PendingEvents)
     {
-        if (DetectedMissiles[i].Missile == Missile)
+        if (Event.DetectionCount == SimParams.MaxDetections && !Event.bImpactPredicted)
         {
-            ExistingIndex = i;
-            break;
+            MEL_DEBUG(Info, MakeTuple(this, Event.RocketNumber), 10.0f, FColor::Red,
+                TEXT("Траектория ракеты #%d:\nСкорость: X=%.2f, Y=%.2f, Z=%.2f\nПрогноз падения недоступен"),
+                Event.RocketNumber, Event.Velocity.X, Event.Velocity.Y, Event.Velocity.Z);
         }
+        else if (Event.DetectionCount == SimParams.MaxDetections)
+        {
+            MEL_DEBUG(Info, MakeTuple(this, Event.RocketNumber), 10.0f, FColor::Red,
+                TEXT("Траектория ракеты #%d:\nСкорость: X=%.2f, Y=%.2f, Z=%.2f\nВремя до падения: %.2f сек\nТочка падения: X=%.0f, Y=%.0f, Z=%.0f"),
+                Event.RocketNumber, Event.Velocity.X, Event.Velocity.Y, Event.Velocity.Z, Event.TimeToGround,
+                Event.ImpactPoint.X, Event.ImpactPoint.Y, Event.ImpactPoint.Z);
+        }
+        else if (Event.DetectionCount == 3)
+        {
+            MEL_DEBUG(Info, MakeTuple(this, Event.RocketNumber), 3.0f, FColor::Yellow,
+                TEXT("Ракета #%d обнаружена третий раз! Координаты: X=%.0f, Y=%.0f, Z=%.0f"),
+                Event.RocketNumber, Event.Position.X, Event.Position.Y, Event.Position.Z);
+        }
+        else if (Event.DetectionCount == 2)
+        {
+            MEL_DEBUG(Info, MakeTuple(this, Event.RocketNumber), 3.0f, FColor::Yellow,
+                TEXT("Ракета #%d обнаружена второй раз! Координаты: X=%.0f, Y=%.0f, Z=%.0f"),
+                Event.RocketNumber, Event.Position.X, Event.Position.Y, Event.Position.Z);
+        }
+        else
+        {
+            MEL_DEBUG(Info, MakeTuple(this, Event.RocketNumber), 3.0f, FColor::Yellow,
+                TEXT("Ракета #%d обнаружена! Координаты: X=%.0f, Y=%.0f, Z=%.0f"),
+                Event.RocketNumber, Event.Position.X, Event.Position.Y, Event.Position.Z);
+        }
+        PlayPingSound();
     }
+    PendingEvents.Reset();
 
-    if (ExistingIndex >= 0)
+#if MEL_DEBUG_ENABLED
+    // Выводим информацию о наиболее опасных ракетах (таблица держит их упорядоченными по угрозе)
+    int32 i = 0;
+    Tracks.VisitByThreat([this, &i](FRadarTrackId TrackId, const FMissileData& MissileData)
     {
-        FMissileData& MissileData = DetectedMissiles[ExistingIndex];
-        MissileData.Position = CurrentPosition;
-        MissileData.Velocity = CurrentVelocity;
-        MissileData.Distance = (CurrentPosition - GetActorLocation()).Size();
-        MissileData.LastDetectionTime = GetWorld()->GetTimeSeconds();
-        if (MissileData.bReportedTrajectory) {
-            // После 4 сообщений больше ничего не выводим
-            return;
-        }
-        if (MissileData.DetectionCount < 4) {
-            MissileData.DetectionCount++;
+        if (MissileData.Missile && MissileData.Missile->IsValidLowLevel())
+        {
+            const FColor MessageColor = (i == 0) ? FColor::Red : (i == 1) ? FColor::Orange : FColor::Yellow;
+            MEL_DEBUG(Verbose, MakeTuple(this, i), 0.1f, MessageColor,
+                TEXT("РАДАР #%d: Ракета обнаружена! Угроза: %.2f | Координаты: X=%.0f, Y=%.0f, Z=%.0f | Скорость: %.0f м/с"),
+                i + 1,
+                MissileData.ThreatLevel,
+                MissileData.Position.X,
+                MissileData.Position.Y,
+                MissileData.Position.Z,
+                MissileData.Velocity.Size());
         }
-        PredictMissileTrajectory(MissileData);
-        MissileData.ThreatLevel = CalculateThreatLevel(MissileData);
-
-        int32 RocketNumber = ExistingIndex + 1;
-        if (MissileData.DetectionCount == 1) {
-            FString Message = FString::Printf(TEXT("Ракета #%d обнаружена! Координаты: X=%.0f, Y=%.0f, Z=%.0f"),
-                RocketNumber, CurrentPosition.X, CurrentPosition.Y, CurrentPosition.Z);
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, Message);
-            PlayPingSound();
-        } else if (MissileData.DetectionCount == 2) {
-            FString Message = FString::Printf(TEXT("Ракета #%d обнаружена второй раз! Координаты: X=%.0f, Y=%.0f, Z=%.0f"),
-                RocketNumber, CurrentPosition.X, CurrentPosition.Y, CurrentPosition.Z);
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, Message);
-            PlayPingSound();
-        } else if (MissileData.DetectionCount == 3) {
-            FString Message = FString::Printf(TEXT("Ракета #%d обнаружена третий раз! Координаты: X=%.0f, Y=%.0f, Z=%.0f"),
-                RocketNumber, CurrentPosition.X, CurrentPosition.Y, CurrentPosition.Z);
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, Message);
-            PlayPingSound();
-        } else if (MissileData.DetectionCount == 4) {
-            float TimeToGround = CalculateTimeToImpact(MissileData);
-            FVector ImpactPoint = CurrentPosition + CurrentVelocity * TimeToGround;
-            FString TrajectoryMessage = FString::Printf(TEXT("Траектория ракеты #%d:\nСкорость: X=%.2f, Y=%.2f, Z=%.2f\nВремя до падения: %.2f сек\nТочка падения: X=%.0f, Y=%.0f, Z=%.0f"),
-                RocketNumber, CurrentVelocity.X, CurrentVelocity.Y, CurrentVelocity.Z, TimeToGround, ImpactPoint.X, ImpactPoint.Y, ImpactPoint.Z);
-            GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TrajectoryMessage);
-            PlayPingSound();
-            MissileData.bReportedTrajectory = true; // После этого больше не выводим сообщений
+        return ++i >= 3;
+    });
+#endif
+}
+
+void ARadarActor::UpdateMissileData(AMissleActor* Missile, float CurrentTime)
+{
+    if (!Missile || !Missile->IsValidLowLevel())
+        return;
+
+    // Радар измеряет только положение; скорость и ускорение оценивает фильтр трека
+    const FVector CurrentPosition = Missile->GetActorLocation();
+
+    FRadarTrackId TrackId = Tracks.FindId(Missile);
+    int32 DetectionCount = 0;
+    if (TrackId.IsValid())
+    {
+        FMissileData& MissileData = *Tracks.Find(TrackId);
+        Tracks.Touch(TrackId, CurrentTime);
+
+        // Трек дальней зоны между редкими обновлениями только продлевается
+        const float DetectionDistance = FVector::Dist(CurrentPosition, GetActorLocation());
+        if (MelSim::ShouldSkipFarFieldUpdate(SimParams, Tracks.GetEstimate(Tracks.GetIndex(TrackId)), DetectionDistance, MissileData.ThreatLevel, CurrentTime))
+            return;
+
+        // После MaxDetections сообщений трек только сопровождается: оценка уточняется, сообщений нет
+        const bool bFarField = MelSim::IsFarFieldTrack(SimParams, DetectionDistance, MissileData.ThreatLevel);
+        if (MelSim::CountDetection(SimParams, bFarField, MissileData.DetectionCount, MissileData.bReportedTrajectory))
+        {
+            DetectionCount = MissileData.DetectionCount;
         }
     }
     else
@@ -206,204 +307,111 @@ void ARadarActor::UpdateMissileData(AActor* Missile)
         FMissileData NewMissileData;
         NewMissileData.Missile = Missile;
         NewMissileData.Position = CurrentPosition;
-        NewMissileData.Velocity = CurrentVelocity;
-        NewMissileData.Distance = (CurrentPosition - GetActorLocation()).Size();
-        NewMissileData.LastDetectionTime = GetWorld()->GetTimeSeconds();
+        NewMissileData.LastDetectionTime = CurrentTime;
         NewMissileData.DetectionCount = 1;
         NewMissileData.bReportedTrajectory = false;
-        PredictMissileTrajectory(NewMissileData);
-        NewMissileData.ThreatLevel = CalculateThreatLevel(NewMissileData);
-        DetectedMissiles.Add(NewMissileData);
-        int32 RocketNumber = DetectedMissiles.Num();
-        FString Message = FString::Printf(TEXT("Ракета #%d обнаружена! Координаты: X=%.0f, Y=%.0f, Z=%.0f"),
-            RocketNumber, CurrentPosition.X, CurrentPosition.Y, CurrentPosition.Z);
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, Message);
-        PlayPingSound();
+        TrackId = Tracks.Add(NewMissileData);
+        DetectionCount = 1;
     }
-}
 
-void ARadarActor::PredictMissileTrajectory(FMissileData& MissileData)
-{
-    if (MissileData.Velocity.SizeSquared() < 1.0f)
-        return;
+    // Подтверждение решает сеть по сумме обнаружений всех радаров после сканов шага
+    if (DetectionCount > 0 && !Tracks.IsConfirmed(TrackId))
+    {
+        PendingConfirmations.Add(Missile);
+    }
 
-    // Простое предсказание: ракета продолжит движение с текущей скоростью
-    MissileData.PredictedPosition = MissileData.Position + MissileData.Velocity * PredictionTime;
-    
-    // Если ракета движется вниз, предсказываем точку падения
-    if (MissileData.Velocity.Z < -100.0f) // Значительная скорость вниз
+    // Во время скана треки только добавляются, поэтому плотный индекс действителен до ApplyMeasurements
+    MelSim::FTrackMeasurement Measurement;
+    Measurement.Index = Tracks.GetIndex(TrackId);
+    Measurement.Position = MelSim::ToSim(CurrentPosition);
+    Measurement.Time = CurrentTime;
+    PendingMeasurements.Add(Measurement);
+
+    if (DetectionCount > 0)
     {
-        float TimeToGround = -MissileData.Position.Z / MissileData.Velocity.Z;
-        if (TimeToGround > 0.0f && TimeToGround < PredictionTime)
-        {
-            MissileData.PredictedPosition = MissileData.Position + MissileData.Velocity * TimeToGround;
-            MissileData.PredictedPosition.Z = 0.0f; // Устанавливаем на уровень земли
-        }
+        // Номер ракеты - слот трека, он не меняется, пока трек жив
+        FDetectionEvent Event;
+        Event.RocketNumber = TrackId.Slot + 1;
+        Event.DetectionCount = DetectionCount;
+        Event.TrackIndex = Measurement.Index;
+        Event.Position = CurrentPosition;
+        Event.Velocity = FVector::ZeroVector;
+        Event.bImpactPredicted = false;
+        Event.TimeToGround = 0.0f;
+        Event.ImpactPoint = FVector::ZeroVector;
+        PendingEvents.Add(Event);
     }
 }
 
-float ARadarActor::CalculateTimeToImpact(const FMissileData& MissileData)
+void ARadarActor::ApplyMeasurements(float CurrentTime)
 {
-    FVector Position = MissileData.Position;
-    FVector Velocity = MissileData.Velocity;
-    
-    // Если ракета уже на земле или ниже
-    if (Position.Z <= 0.0f)
-        return 0.0f;
-    
-    // Если ракета движется вверх или горизонтально, нужно дождаться фазы снижения
-    if (Velocity.Z >= 0.0f)
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarTrackFilter);
+
+    // Фильтры всех обнаруженных за скан треков - одним проходом по плотному массиву оценок
+    MelSim::UpdateTrackEstimates(SimParams.Filter, Tracks.GetEstimates(), PendingMeasurements.GetData(), PendingMeasurements.Num());
+
+    for (const MelSim::FTrackMeasurement& Measurement : PendingMeasurements)
     {
-        // Ракета еще не начала снижаться
-        // Оцениваем время до начала снижения на основе текущей высоты и скорости
-        float TimeToPeak = Velocity.Z / 1500.0f; // Примерное время до пика (можно уточнить)
-        float TimeToDescent = TimeToPeak + 2.0f; // Дополнительное время на горизонтальный полет
-        
-        // Если ракета на большой высоте, добавляем время горизонтального полета
-        if (Position.Z > 15000.0f)
+        const MelSim::FTrackEstimate& Estimate = Tracks.GetEstimate(Measurement.Index);
+        FMissileData& MissileData = Tracks.GetTrack(Measurement.Index);
+        MissileData.Position = MelSim::ToUE(Estimate.Position);
+        MissileData.Velocity = MelSim::ToUE(Estimate.Velocity);
+        MissileData.Acceleration = MelSim::ToUE(Estimate.Acceleration);
+        MissileData.Distance = (MissileData.Position - GetActorLocation()).Size();
+
+        // Прогноз траектории только для треков полной детализации
+        if (!MelSim::IsFarFieldTrack(SimParams, MissileData.Distance, MissileData.ThreatLevel))
         {
-            TimeToDescent += 5.0f; // Дополнительное время для горизонтального полета
+            PredictMissileTrajectory(MissileData);
         }
-        
-        return TimeToDescent;
+        Tracks.SetThreatLevel(Tracks.GetId(Measurement.Index), CalculateThreatLevel(MissileData));
     }
-    else
+    PendingMeasurements.Reset();
+
+    // События скана получают оценку после фильтра
+    for (FDetectionEvent& Event : PendingEvents)
     {
-        // Ракета уже снижается - используем более точный расчет
-        float Gravity = 1500.0f; // Ускорение свободного падения (можно уточнить)
-        float DragCoefficient = 0.1f; // Коэффициент сопротивления воздуха
-        
-        // Учитываем сопротивление воздуха
-        float EffectiveGravity = Gravity * (1.0f + DragCoefficient * Velocity.Size() / 1000.0f);
-        
-        // Используем квадратичную формулу для расчета времени с учетом ускорения
-        // h = h0 + v0*t + 0.5*a*t^2, где a = -EffectiveGravity
-        // Решаем: 0 = h0 + v0*t - 0.5*EffectiveGravity*t^2
-        
-        float a = -0.5f * EffectiveGravity;
-        float b = Velocity.Z;
-        float c = Position.Z;
-        
-        // Дискриминант
-        float Discriminant = b * b - 4.0f * a * c;
-        
-        if (Discriminant >= 0.0f)
-        {
-            float t1 = (-b + FMath::Sqrt(Discriminant)) / (2.0f * a);
-            float t2 = (-b - FMath::Sqrt(Discriminant)) / (2.0f * a);
-            
-            // Выбираем положительное время
-            float TimeToGround = (t1 > 0.0f) ? t1 : t2;
-            
-            if (TimeToGround > 0.0f)
-            {
-                return TimeToGround;
-            }
+        if (Event.TrackIndex == INDEX_NONE)
+            continue;
+
+        const FMissileData& MissileData = Tracks.GetTracks()[Event.TrackIndex];
+        Event.Position = MissileData.Position;
+        Event.Velocity = MissileData.Velocity;
+        if (Event.DetectionCount == SimParams.MaxDetections) {
+            Event.bImpactPredicted = PredictImpact(MissileData, CurrentTime, Event.TimeToGround, Event.ImpactPoint);
         }
-        
-        // Если квадратичная формула не работает, используем линейную аппроксимацию
-        return -Position.Z / Velocity.Z;
+        Event.TrackIndex = INDEX_NONE;
     }
 }
 
-float ARadarActor::CalculateThreatLevel(const FMissileData& MissileData)
+void ARadarActor::PredictMissileTrajectory(FMissileData& MissileData)
 {
-    float ThreatLevel = 0.0f;
-    
-    // Фактор расстояния (ближе = опаснее)
-    float DistanceFactor = FMath::Clamp(1.0f - (MissileData.Distance / ScanRadius), 0.0f, 1.0f);
-    
-    // Фактор скорости (быстрее = опаснее)
-    float SpeedFactor = FMath::Clamp(MissileData.Velocity.Size() / 2000.0f, 0.0f, 1.0f);
-    
-    // Фактор высоты (ниже = опаснее, так как ближе к цели)
-    float HeightFactor = FMath::Clamp(1.0f - (MissileData.Position.Z / MaxDetectionHeight), 0.0f, 1.0f);
-    
-    // Фактор направления (движение к радару = опаснее)
-    FVector DirectionToRadar = (GetActorLocation() - MissileData.Position).GetSafeNormal();
-    float DirectionFactor = FVector::DotProduct(MissileData.Velocity.GetSafeNormal(), DirectionToRadar);
-    DirectionFactor = FMath::Clamp(DirectionFactor, 0.0f, 1.0f);
-    
-    // Комбинируем факторы
-    ThreatLevel = DistanceFactor * ThreatDistanceWeight +
-                  SpeedFactor * ThreatSpeedWeight +
-                  HeightFactor * ThreatHeightWeight +
-                  DirectionFactor * 0.2f; // Дополнительный вес для направления
-    
-    return FMath::Clamp(ThreatLevel, 0.0f, 1.0f);
+    MelSim::FVec3 PredictedPosition = MelSim::ToSim(MissileData.PredictedPosition);
+    MelSim::PredictTrajectory(SimParams, MelSim::ToSim(MissileData.Position), MelSim::ToSim(MissileData.Velocity), PredictedPosition);
+    MissileData.PredictedPosition = MelSim::ToUE(PredictedPosition);
 }
 
-void ARadarActor::CleanupOldDetections()
+bool ARadarActor::PredictImpact(const FMissileData& MissileData, float CurrentTime, float& OutTimeToImpact, FVector& OutImpactPoint) const
 {
-    float CurrentTime = GetWorld()->GetTimeSeconds();
-    
-    for (int32 i = DetectedMissiles.Num() - 1; i >= 0; i--)
-    {
-        if (CurrentTime - DetectedMissiles[i].LastDetectionTime > 5.0f) // Удаляем через 5 секунд без обнаружения
-        {
-            DetectedMissiles.RemoveAt(i);
-        }
-    }
+    // Профиль полета ракеты известен: прогноз строится подсистемой движения один раз на фазу
+    const AMissleActor* Missile = Cast<AMissleActor>(MissileData.Missile);
+    return Missile && MovementSystem && MovementSystem->PredictImpact(Missile->GetMovementId(), CurrentTime, OutTimeToImpact, OutImpactPoint);
 }
 
-void ARadarActor::SortMissilesByThreat()
+float ARadarActor::CalculateThreatLevel(const FMissileData& MissileData)
 {
-    DetectedMissiles.Sort([](const FMissileData& A, const FMissileData& B) {
-        return A.ThreatLevel > B.ThreatLevel; // Сортировка по убыванию угрозы
-    });
+    return MelSim::ComputeThreatLevel(SimParams, MelSim::ToSim(GetActorLocation()),
+        MelSim::ToSim(MissileData.Position), MelSim::ToSim(MissileData.Velocity), MissileData.Distance);
 }
 
-void ARadarActor::CalculateImpactPoint(const FMissileData& MissileData)
+void ARadarActor::CleanupOldDetections()
 {
-    if (!MissileData.Missile || !MissileData.Missile->IsValidLowLevel())
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("РАДАР: Ошибка - ракета недействительна"));
-        return;
-    }
-
-    FVector CurrentPos = MissileData.Position;
-    FVector Velocity = MissileData.Velocity;
-    
-    // Проверяем, что ракета движется
-    if (Velocity.SizeSquared() < 1.0f)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("РАДАР: Ошибка - ракета не движется"));
-        return;
-    }
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarCleanup);
 
-    // Вычисляем время до падения на основе вертикальной скорости
-    float TimeToGround = 0.0f;
-    if (FMath::Abs(Velocity.Z) > 0.1f)
-    {
-        TimeToGround = -CurrentPos.Z / Velocity.Z;
-    }
-    else
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("РАДАР: Ошибка - недостаточная вертикальная скорость"));
-        return;
-    }
-
-    if (TimeToGround <= 0.0f)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("РАДАР: Ошибка - ракета уже упала"));
-        return;
-    }
+    float CurrentTime = UEngagementClockSubsystem::GetEngagementTime(GetWorld());
 
-    // Вычисляем точку падения
-    FVector ImpactPoint = CurrentPos + Velocity * TimeToGround;
-
-    // Выводим информацию о траектории
-    FString TrajectoryMessage = FString::Printf(TEXT("РАДАР: Анализ траектории ракеты:\n"
-        "Текущая скорость: X=%.2f, Y=%.2f, Z=%.2f\n"
-        "Время до падения: %.2f секунд\n"
-        "Точка падения: X=%.2f, Y=%.2f, Z=%.2f\n"
-        "Уровень угрозы: %.2f"),
-        Velocity.X, Velocity.Y, Velocity.Z,
-        TimeToGround,
-        ImpactPoint.X, ImpactPoint.Y, ImpactPoint.Z,
-        MissileData.ThreatLevel);
-    
-    GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TrajectoryMessage);
+    // Удаляем через 5 секунд без обнаружения; очередь таблицы отдает только истекшие треки
+    Tracks.RemoveExpired(CurrentTime - SimParams.TrackTimeout);
 }
 
 void ARadarActor::PlayPingSound()
@@ -415,19 +423,27 @@ void ARadarActor::PlayPingSound()
     }
 }
 
-TArray<AMissleActor*> ARadarActor::GetMissilesDetectedThreeTimes() const
+AMissleActor* ARadarActor::GetTrackMissile(const FMissileData& MissileData)
+{
+    return static_cast<AMissleActor*>(MissileData.Missile);
+}
+
+void ARadarActor::VisitConfirmedTracks(TFunctionRef<void(AMissleActor*, const FMissileData&)> Visitor) const
+{
+    for (const FMissileData& MissileData : Tracks.GetConfirmed())
+    {
+        Visitor(GetTrackMissile(MissileData), MissileData);
+    }
+}
+
+void ARadarActor::VisitConfirmedTracksInRange(const FVector& Origin, float Radius, TFunctionRef<void(AMissleActor*, const FMissileData&)> Visitor) const
 {
-    TArray<AMissleActor*> Result;
-    for (const FMissileData& MissileData : DetectedMissiles)
+    const float RadiusSquared = FMath::Square(Radius);
+    for (const FMissileData& MissileData : Tracks.GetConfirmed())
     {
-        if (MissileData.DetectionCount >= 3 && MissileData.Missile && MissileData.Missile->IsValidLowLevel())
+        if (FVector::DistSquared(MissileData.Position, Origin) < RadiusSquared)
         {
-            AMissleActor* Missile = Cast<AMissleActor>(MissileData.Missile);
-            if (Missile)
-            {
-                Result.Add(Missile);
-            }
+            Visitor(GetTrackMissile(MissileData), MissileData);
         }
     }
-    return Result;
-} 
\ No newline at end of file
+}
\ No newline at end of file
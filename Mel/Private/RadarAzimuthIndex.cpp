@@ -0,0 +1,202 @@
+#include "RadarAzimuthIndex.h"
+#include "MissleActor.h"
+
+void FRadarAzimuthIndex::Initialize(const UMissileSpatialSubsystem& SpatialIndex, const FVector& InOrigin, float InRadius, float InMaxTargetSpeed)
+{
+    Origin = InOrigin;
+    Radius = InRadius;
+    MaxTargetSpeed = InMaxTargetSpeed;
+
+    // Между обновлениями записи проходит не больше круга и одного кадра - берем запас на два круга
+    const float MaxDrift = MaxTargetSpeed * RefreshPeriod * 2.0f;
+    TrackRadius = Radius + MaxDrift;
+    NearRadius = MaxDrift / FMath::Sin(FMath::DegreesToRadians(BucketWidthDeg)) + MaxDrift;
+
+    Buckets.Reset();
+    Buckets.SetNum(NumBuckets + 1);
+    Known.Reset();
+
+    Cells.Reset();
+    SpatialIndex.GetCellsInRadius(Origin, TrackRadius, Cells);
+
+    NextBucket = 0;
+    NextCell = 0;
+    BucketBudget = 0.0f;
+    CellBudget = 0.0f;
+
+    // Начальное заполнение - сразу по всем ячейкам зоны
+    for (const FIntPoint& Cell : Cells)
+    {
+        DiscoverInCell(SpatialIndex, Cell);
+    }
+}
+
+int32 FRadarAzimuthIndex::GetBucket(const FVector& Location) const
+{
+    const FVector2D Offset = FVector2D(Location) - FVector2D(Origin);
+    if (Offset.SizeSquared() < NearRadius * NearRadius)
+        return NearBucket;
+
+    float AngleDeg = FMath::RadiansToDegrees(FMath::Atan2(Offset.Y, Offset.X));
+    if (AngleDeg < 0.0f)
+    {
+        AngleDeg += 360.0f;
+    }
+    return FMath::Clamp(FMath::FloorToInt(AngleDeg / BucketWidthDeg), 0, NumBuckets - 1);
+}
+
+void FRadarAzimuthIndex::Refresh(const UMissileSpatialSubsystem& SpatialIndex, float DeltaTime)
+{
+    // Доля круга, приходящаяся на этот кадр; длинный кадр обновляет все сразу
+    const float Fraction = FMath::Min(DeltaTime / RefreshPeriod, 1.0f);
+
+    const int32 NumBucketSlots = Buckets.Num();
+    BucketBudget = FMath::Min(BucketBudget + Fraction * NumBucketSlots, static_cast<float>(NumBucketSlots));
+    const int32 NumBucketsToRefresh = FMath::FloorToInt(BucketBudget);
+    BucketBudget -= NumBucketsToRefresh;
+    for (int32 i = 0; i < NumBucketsToRefresh; ++i)
+    {
+        RefreshBucket(SpatialIndex, NextBucket);
+        NextBucket = (NextBucket + 1) % NumBucketSlots;
+    }
+
+    if (Cells.Num() == 0)
+        return;
+
+    CellBudget = FMath::Min(CellBudget + Fraction * Cells.Num(), static_cast<float>(Cells.Num()));
+    const int32 NumCellsToVisit = FMath::FloorToInt(CellBudget);
+    CellBudget -= NumCellsToVisit;
+    for (int32 i = 0; i < NumCellsToVisit; ++i)
+    {
+        DiscoverInCell(SpatialIndex, Cells[NextCell]);
+        NextCell = (NextCell + 1) % Cells.Num();
+    }
+}
+
+void FRadarAzimuthIndex::RefreshBucket(const UMissileSpatialSubsystem& SpatialIndex, int32 Bucket)
+{
+    const float TrackRadiusSquared = TrackRadius * TrackRadius;
+    TArray<AMissleActor*>& Entries = Buckets[Bucket];
+
+    // Обход с конца: RemoveAtSwap переносит на место i уже проверенный элемент
+    for (int32 i = Entries.Num() - 1; i >= 0; --i)
+    {
+        AMissleActor* Missile = Entries[i];
+
+        // Ракета уничтожена или ушла из зоны радара
+        FVector Location;
+        if (!SpatialIndex.GetMissileLocation(Missile, Location) ||
+            FVector2D::DistSquared(FVector2D(Location), FVector2D(Origin)) > TrackRadiusSquared)
+        {
+            Entries.RemoveAtSwap(i);
+            Known.Remove(Missile);
+            continue;
+        }
+
+        const int32 NewBucket = GetBucket(Location);
+        if (NewBucket != Bucket)
+        {
+            Entries.RemoveAtSwap(i);
+            Buckets[NewBucket].Add(Missile);
+        }
+    }
+}
+
+void FRadarAzimuthIndex::DiscoverInCell(const UMissileSpatialSubsystem& SpatialIndex, const FIntPoint& Cell)
+{
+    const float TrackRadiusSquared = TrackRadius * TrackRadius;
+
+    SpatialIndex.ForEachInCell(Cell, [this, TrackRadiusSquared](AMissleActor* Missile, const FVector& Location)
+    {
+        if (FVector2D::DistSquared(FVector2D(Location), FVector2D(Origin)) > TrackRadiusSquared)
+            return;
+
+        bool bAlreadyKnown = false;
+        Known.Add(Missile, &bAlreadyKnown);
+        if (!bAlreadyKnown)
+        {
+            Buckets[GetBucket(Location)].Add(Missile);
+        }
+    });
+}
+
+void FRadarAzimuthIndex::Remove(AMissleActor* Missile)
+{
+    if (!Known.Remove(Missile))
+        return;
+
+    // Корзина записи могла устареть - ищем во всех
+    for (TArray<AMissleActor*>& Entries : Buckets)
+    {
+        if (Entries.RemoveSingleSwap(Missile, EAllowShrinking::No) > 0)
+            return;
+    }
+}
+
+void FRadarAzimuthIndex::TestBucket(const UMissileSpatialSubsystem& SpatialIndex, const FRadarSectorQuery& Query, const FRadarSectorTest& Sector,
+                                    int32 Bucket, TArray<AMissleActor*>& OutMissiles) const
+{
+    for (AMissleActor* Missile : Buckets[Bucket])
+    {
+        FVector Location;
+        if (!SpatialIndex.GetMissileLocation(Missile, Location))
+            continue;
+
+        if (Query.Age > 0.0f)
+        {
+            Location -= Missile->GetCurrentVelocity() * Query.Age;
+        }
+        if (Sector.Contains(Location))
+        {
+            OutMissiles.Add(Missile);
+        }
+    }
+}
+
+template <typename FuncType>
+void FRadarAzimuthIndex::ForEachSectorBucket(const FRadarSectorQuery& Query, FuncType&& Func) const
+{
+    Func(NearBucket);
+
+    // Корзины луча плюс соседние на возможный сдвиг с последнего обновления:
+    // одна покрывает два круга обновления, отмотка назад на Age добавляет еще
+    const int32 GuardBuckets = 1 + FMath::CeilToInt(Query.Age / (RefreshPeriod * 2.0f));
+    const float HalfWidth = Query.WidthDeg * 0.5f;
+    if (HalfWidth + BucketWidthDeg * (GuardBuckets + 1) >= 180.0f)
+    {
+        for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+        {
+            Func(Bucket);
+        }
+        return;
+    }
+
+    const int32 FirstBucket = FMath::FloorToInt((Query.CenterAngleDeg - HalfWidth) / BucketWidthDeg) - GuardBuckets;
+    const int32 LastBucket = FMath::FloorToInt((Query.CenterAngleDeg + HalfWidth) / BucketWidthDeg) + GuardBuckets;
+    for (int32 Bucket = FirstBucket; Bucket <= LastBucket; ++Bucket)
+    {
+        Func((Bucket % NumBuckets + NumBuckets) % NumBuckets);
+    }
+}
+
+void FRadarAzimuthIndex::QuerySector(const UMissileSpatialSubsystem& SpatialIndex, const FRadarSectorQuery& Query, TArray<AMissleActor*>& OutMissiles) const
+{
+    const FRadarSectorTest Sector(Query);
+    ForEachSectorBucket(Query, [&](int32 Bucket)
+    {
+        TestBucket(SpatialIndex, Query, Sector, Bucket, OutMissiles);
+    });
+}
+
+void FRadarAzimuthIndex::GetSectorBuckets(const FRadarSectorQuery& Query, TArray<int32>& OutBuckets) const
+{
+    ForEachSectorBucket(Query, [&OutBuckets](int32 Bucket)
+    {
+        OutBuckets.Add(Bucket);
+    });
+}
+
+void FRadarAzimuthIndex::QuerySectorBucket(const UMissileSpatialSubsystem& SpatialIndex, const FRadarSectorQuery& Query, int32 Bucket, TArray<AMissleActor*>& OutMissiles) const
+{
+    TestBucket(SpatialIndex, Query, FRadarSectorTest(Query), Bucket, OutMissiles);
+}
@@ -0,0 +1,245 @@
+#include "RadarNetworkSubsystem.h"
+#include "RadarActor.h"
+#include "EngagementClockSubsystem.h"
+#include "MelStats.h"
+#include "MelSimBridge.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarRadarParallelScan(
+    TEXT("mel.Radar.ParallelScan"),
+    1,
+    TEXT("1 - сканы всех радаров выполняются за кадр на рабочих потоках, 0 - каждый радар сканирует в своем шаге"),
+    ECVF_Default);
+
+bool URadarNetworkSubsystem::IsParallelScanEnabled()
+{
+    return CVarRadarParallelScan.GetValueOnGameThread() != 0;
+}
+
+void URadarNetworkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    SpatialIndex = Collection.InitializeDependency<UMissileSpatialSubsystem>();
+}
+
+TStatId URadarNetworkSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URadarNetworkSubsystem, STATGROUP_Tickables);
+}
+
+void URadarNetworkSubsystem::RegisterRadar(ARadarActor* Radar)
+{
+    if (Radar)
+    {
+        Radars.AddUnique(Radar);
+    }
+}
+
+void URadarNetworkSubsystem::UnregisterRadar(ARadarActor* Radar)
+{
+    // RemoveSingle сохраняет порядок регистрации - от него зависит порядок вывода
+    Radars.RemoveSingle(Radar);
+}
+
+void URadarNetworkSubsystem::ForgetMissile(AMissleActor* Missile)
+{
+    for (ARadarActor* Radar : Radars)
+    {
+        Radar->ForgetMissile(Missile);
+    }
+    FusedTime = -1.0f;
+}
+
+const TArray<FRadarFusedTrack>& URadarNetworkSubsystem::GetFusedTracks(float Time)
+{
+    if (Time == FusedTime)
+        return FusedTracks;
+
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarFusion);
+    FusedTime = Time;
+    FusedTracks.Reset();
+    FusedEstimates.Reset();
+    FusedIndexByMissile.Reset();
+
+    // Ассоциация по ракете: подтвержденные треки разных радаров одной ракеты дают один слитый трек.
+    // Сеть подтверждает треки ракеты во всех радарах сразу, поэтому остальные треки не нужны.
+    for (const ARadarActor* Radar : Radars)
+    {
+        const FRadarConfirmedTrackView ConfirmedTracks = Radar->GetConfirmedTracks();
+        for (int32 Position = 0; Position < ConfirmedTracks.Num(); ++Position)
+        {
+            const FMissileData& Track = ConfirmedTracks[Position];
+            AMissleActor* Missile = ARadarActor::GetTrackMissile(Track);
+
+            int32& FusedIndex = FusedIndexByMissile.FindOrAdd(Missile, INDEX_NONE);
+            if (FusedIndex == INDEX_NONE)
+            {
+                FusedIndex = FusedTracks.AddDefaulted();
+                FusedTracks[FusedIndex].Missile = Missile;
+                FusedEstimates.AddDefaulted();
+            }
+
+            FRadarFusedTrack& Fused = FusedTracks[FusedIndex];
+            Fused.ThreatLevel = FMath::Max(Fused.ThreatLevel, Track.ThreatLevel);
+            FusedEstimates[FusedIndex].Add(ConfirmedTracks.GetEstimate(Position), Time);
+        }
+    }
+
+    for (int32 FusedIndex = 0; FusedIndex < FusedTracks.Num(); ++FusedIndex)
+    {
+        FusedTracks[FusedIndex].Position = MelSim::ToUE(FusedEstimates[FusedIndex].GetPosition());
+        FusedTracks[FusedIndex].Velocity = MelSim::ToUE(FusedEstimates[FusedIndex].GetVelocity());
+    }
+
+    return FusedTracks;
+}
+
+void URadarNetworkSubsystem::ConfirmTracks()
+{
+    for (ARadarActor* Radar : Radars)
+    {
+        for (AMissleActor* Missile : Radar->PendingConfirmations)
+        {
+            // Треки ракеты во всех радарах: сумма обнаружений, наименьший порог, уже подтвержденные
+            int32 DetectionCount = 0;
+            int32 ConfirmDetections = MAX_int32;
+            bool bConfirmed = false;
+            for (const ARadarActor* Other : Radars)
+            {
+                const FRadarTrackId TrackId = Other->Tracks.FindId(Missile);
+                if (const FMissileData* Track = Other->Tracks.Find(TrackId))
+                {
+                    DetectionCount += Track->DetectionCount;
+                    ConfirmDetections = FMath::Min(ConfirmDetections, Other->SimParams.ConfirmDetections);
+                    bConfirmed |= Other->Tracks.IsConfirmed(TrackId);
+                }
+            }
+
+            if (!bConfirmed && DetectionCount < ConfirmDetections)
+                continue;
+
+            for (ARadarActor* Other : Radars)
+            {
+                Other->Tracks.Confirm(Other->Tracks.FindId(Missile));
+            }
+            FusedTime = -1.0f;
+        }
+        Radar->PendingConfirmations.Reset();
+    }
+}
+
+void URadarNetworkSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+#if STATS
+    int32 NumTracks = 0;
+    for (const ARadarActor* Radar : Radars)
+    {
+        NumTracks += Radar->Tracks.Num();
+    }
+    SET_DWORD_STAT(STAT_MelRadarTracks, NumTracks);
+#endif
+}
+
+void URadarNetworkSubsystem::StepRadars(float DeltaTime)
+{
+    for (ARadarActor* Radar : Radars)
+    {
+        Radar->StepEngagement(DeltaTime);
+    }
+
+    ScanPendingRadars();
+    ConfirmTracks();
+
+    // Очистка после сканов в обоих режимах: трек, истекающий в шаге повторного обнаружения, сохраняется
+    for (ARadarActor* Radar : Radars)
+    {
+        Radar->CleanupOldDetections();
+    }
+}
+
+void URadarNetworkSubsystem::ScanPendingRadars()
+{
+    if (!IsParallelScanEnabled())
+        return;
+
+    PendingScans.Reset();
+    for (ARadarActor* Radar : Radars)
+    {
+        if (Radar->PendingScanQueries.Num() > 0)
+        {
+            PendingScans.Add(Radar);
+        }
+    }
+
+    if (PendingScans.Num() > 0 && SpatialIndex)
+    {
+        RunParallelScan();
+    }
+}
+
+void URadarNetworkSubsystem::RunParallelScan()
+{
+    SCOPE_CYCLE_COUNTER(STAT_MelRadarNetworkScan);
+
+    const int32 NumScans = PendingScans.Num();
+    const float CurrentTime = UEngagementClockSubsystem::GetEngagementTime(GetWorld());
+
+    // Разбиение сканов на части: корзины каждого под-скана в порядке последовательного запроса
+    ScanChunks.Reset();
+    ScanFirstChunks.Reset();
+    for (int32 ScanIndex = 0; ScanIndex < NumScans; ++ScanIndex)
+    {
+        const ARadarActor* Radar = PendingScans[ScanIndex];
+        ScanFirstChunks.Add(ScanChunks.Num());
+        if (!Radar->SpatialIndex)
+            continue;
+
+        for (int32 QueryIndex = 0; QueryIndex < Radar->PendingScanQueries.Num(); ++QueryIndex)
+        {
+            SectorBuckets.Reset();
+            Radar->AzimuthIndex.GetSectorBuckets(Radar->PendingScanQueries[QueryIndex], SectorBuckets);
+            for (int32 Bucket : SectorBuckets)
+            {
+                ScanChunks.Add({ ScanIndex, QueryIndex, Bucket });
+            }
+        }
+    }
+    ScanFirstChunks.Add(ScanChunks.Num());
+
+    // Отбор кандидатов по частям: пространственный и азимутальные индексы только читаются,
+    // каждая часть пишет в свой буфер
+    const int32 NumChunks = ScanChunks.Num();
+    if (ChunkCandidates.Num() < NumChunks)
+    {
+        ChunkCandidates.SetNum(NumChunks);
+    }
+    ParallelFor(NumChunks, [this](int32 ChunkIndex)
+    {
+        const FScanChunk& Chunk = ScanChunks[ChunkIndex];
+        const ARadarActor* Radar = PendingScans[Chunk.ScanIndex];
+        TArray<AMissleActor*>& Candidates = ChunkCandidates[ChunkIndex];
+        Candidates.Reset();
+        Radar->AzimuthIndex.QuerySectorBucket(*Radar->SpatialIndex, Radar->PendingScanQueries[Chunk.QueryIndex], Chunk.Bucket, Candidates);
+    });
+
+    // Обновление треков: у каждого радара своя таблица, события копятся в радаре.
+    // Части радара применяются по порядку, как в последовательном скане.
+    ParallelFor(NumScans, [this, CurrentTime](int32 ScanIndex)
+    {
+        ARadarActor* Radar = PendingScans[ScanIndex];
+        for (int32 ChunkIndex = ScanFirstChunks[ScanIndex]; ChunkIndex < ScanFirstChunks[ScanIndex + 1]; ++ChunkIndex)
+        {
+            Radar->ProcessScanCandidates(ChunkCandidates[ChunkIndex], CurrentTime);
+        }
+        Radar->CompletePendingScans(CurrentTime);
+    });
+
+    // Сообщения и звук - на игровом потоке
+    for (ARadarActor* Radar : PendingScans)
+    {
+        Radar->FinishScan();
+    }
+}
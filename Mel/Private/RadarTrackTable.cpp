@@ -0,0 +1,247 @@
+#include "RadarTrackTable.h"
+
+void FRadarTrackTable::Reserve(int32 Number)
+{
+    Tracks.Reserve(Number);
+    Estimates.Reserve(Number);
+    TrackSlots.Reserve(Number);
+    Slots.Reserve(Number);
+    ConfirmedSlots.Reserve(Number);
+    SlotByMissile.Reserve(Number);
+}
+
+void FRadarTrackTable::Reset()
+{
+    Tracks.Reset();
+    Estimates.Reset();
+    TrackSlots.Reset();
+    Slots.Reset();
+    FreeSlots.Reset();
+    ConfirmedSlots.Reset();
+    SlotByMissile.Reset();
+    ThreatRanking.Reset();
+    OldestSlot = INDEX_NONE;
+    NewestSlot = INDEX_NONE;
+}
+
+FRadarTrackId FRadarTrackTable::Add(const FMissileData& Track)
+{
+    check(!SlotByMissile.Contains(Track.Missile));
+
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Slot = Slots.AddDefaulted();
+    }
+
+    Slots[Slot].Index = Tracks.Add(Track);
+    Estimates.AddDefaulted();
+    TrackSlots.Add(Slot);
+    SlotByMissile.Add(Track.Missile, Slot);
+    ThreatRanking.Set(Slot, Track.ThreatLevel);
+    LinkNewest(Slot);
+
+    return { Slot, Slots[Slot].Generation };
+}
+
+bool FRadarTrackTable::Remove(FRadarTrackId Id)
+{
+    if (GetIndex(Id) == INDEX_NONE)
+        return false;
+
+    RemoveSlot(Id.Slot);
+    return true;
+}
+
+void FRadarTrackTable::RemoveSlot(int32 Slot)
+{
+    FSlot& Removed = Slots[Slot];
+    const int32 Index = Removed.Index;
+
+    SlotByMissile.Remove(Tracks[Index].Missile);
+    ThreatRanking.Remove(Slot);
+    Unlink(Slot);
+
+    if (Removed.ConfirmedIndex != INDEX_NONE)
+    {
+        const int32 ConfirmedIndex = Removed.ConfirmedIndex;
+        ConfirmedSlots.RemoveAtSwap(ConfirmedIndex, EAllowShrinking::No);
+        if (ConfirmedSlots.IsValidIndex(ConfirmedIndex))
+        {
+            Slots[ConfirmedSlots[ConfirmedIndex]].ConfirmedIndex = ConfirmedIndex;
+        }
+        Removed.ConfirmedIndex = INDEX_NONE;
+    }
+
+    // Последний трек переезжает на место удаленного
+    Tracks.RemoveAtSwap(Index, EAllowShrinking::No);
+    Estimates.RemoveAtSwap(Index, EAllowShrinking::No);
+    TrackSlots.RemoveAtSwap(Index, EAllowShrinking::No);
+    if (TrackSlots.IsValidIndex(Index))
+    {
+        Slots[TrackSlots[Index]].Index = Index;
+    }
+
+    Removed.Index = INDEX_NONE;
+    ++Removed.Generation;
+    FreeSlots.Add(Slot);
+}
+
+FRadarTrackId FRadarTrackTable::FindId(const AActor* Missile) const
+{
+    const int32* Slot = SlotByMissile.Find(Missile);
+    if (!Slot)
+        return FRadarTrackId();
+
+    return { *Slot, Slots[*Slot].Generation };
+}
+
+FMissileData* FRadarTrackTable::Find(FRadarTrackId Id)
+{
+    const int32 Index = GetIndex(Id);
+    return Index != INDEX_NONE ? &Tracks[Index] : nullptr;
+}
+
+const FMissileData* FRadarTrackTable::Find(FRadarTrackId Id) const
+{
+    const int32 Index = GetIndex(Id);
+    return Index != INDEX_NONE ? &Tracks[Index] : nullptr;
+}
+
+FRadarTrackId FRadarTrackTable::GetId(int32 Index) const
+{
+    const int32 Slot = TrackSlots[Index];
+    return { Slot, Slots[Slot].Generation };
+}
+
+int32 FRadarTrackTable::GetIndex(FRadarTrackId Id) const
+{
+    if (!Slots.IsValidIndex(Id.Slot) || Slots[Id.Slot].Generation != Id.Generation)
+        return INDEX_NONE;
+
+    return Slots[Id.Slot].Index;
+}
+
+void FRadarTrackTable::Touch(FRadarTrackId Id, float Time)
+{
+    const int32 Index = GetIndex(Id);
+    if (Index == INDEX_NONE)
+        return;
+
+    Tracks[Index].LastDetectionTime = Time;
+    if (NewestSlot != Id.Slot)
+    {
+        Unlink(Id.Slot);
+        LinkNewest(Id.Slot);
+    }
+}
+
+int32 FRadarTrackTable::RemoveExpired(float OlderThan)
+{
+    int32 NumRemoved = 0;
+    while (OldestSlot != INDEX_NONE && Tracks[Slots[OldestSlot].Index].LastDetectionTime < OlderThan)
+    {
+        RemoveSlot(OldestSlot);
+        ++NumRemoved;
+    }
+    return NumRemoved;
+}
+
+void FRadarTrackTable::Confirm(FRadarTrackId Id)
+{
+    if (GetIndex(Id) == INDEX_NONE || Slots[Id.Slot].ConfirmedIndex != INDEX_NONE)
+        return;
+
+    Slots[Id.Slot].ConfirmedIndex = ConfirmedSlots.Add(Id.Slot);
+}
+
+bool FRadarTrackTable::IsConfirmed(FRadarTrackId Id) const
+{
+    return GetIndex(Id) != INDEX_NONE && Slots[Id.Slot].ConfirmedIndex != INDEX_NONE;
+}
+
+void FRadarTrackTable::SetThreatLevel(FRadarTrackId Id, float ThreatLevel)
+{
+    const int32 Index = GetIndex(Id);
+    if (Index == INDEX_NONE)
+        return;
+
+    Tracks[Index].ThreatLevel = ThreatLevel;
+    ThreatRanking.Set(Id.Slot, ThreatLevel);
+}
+
+void FRadarTrackTable::VisitByThreat(TFunctionRef<bool(FRadarTrackId, const FMissileData&)> Visitor) const
+{
+    ThreatRanking.VisitDescending([this, &Visitor](int32 Slot)
+    {
+        const FSlot& Visited = Slots[Slot];
+        return Visitor(FRadarTrackId{ Slot, Visited.Generation }, Tracks[Visited.Index]);
+    });
+}
+
+void FRadarTrackTable::LinkNewest(int32 Slot)
+{
+    FSlot& Linked = Slots[Slot];
+    Linked.Prev = NewestSlot;
+    Linked.Next = INDEX_NONE;
+
+    if (NewestSlot != INDEX_NONE)
+    {
+        Slots[NewestSlot].Next = Slot;
+    }
+    else
+    {
+        OldestSlot = Slot;
+    }
+    NewestSlot = Slot;
+}
+
+void FRadarTrackTable::Unlink(int32 Slot)
+{
+    FSlot& Unlinked = Slots[Slot];
+
+    if (Unlinked.Prev != INDEX_NONE)
+    {
+        Slots[Unlinked.Prev].Next = Unlinked.Next;
+    }
+    else
+    {
+        OldestSlot = Unlinked.Next;
+    }
+
+    if (Unlinked.Next != INDEX_NONE)
+    {
+        Slots[Unlinked.Next].Prev = Unlinked.Prev;
+    }
+    else
+    {
+        NewestSlot = Unlinked.Prev;
+    }
+
+    Unlinked.Prev = INDEX_NONE;
+    Unlinked.Next = INDEX_NONE;
+}
+
+int32 FRadarConfirmedTrackView::Num() const
+{
+    return Table.ConfirmedSlots.Num();
+}
+
+const FMissileData& FRadarConfirmedTrackView::operator[](int32 Position) const
+{
+    return Table.Tracks[Table.Slots[Table.ConfirmedSlots[Position]].Index];
+}
+
+const MelSim::FTrackEstimate& FRadarConfirmedTrackView::GetEstimate(int32 Position) const
+{
+    return Table.Estimates[Table.Slots[Table.ConfirmedSlots[Position]].Index];
+}
+
+const FMissileData& FRadarConfirmedTrackView::FIterator::operator*() const
+{
+    return Table->Tracks[Table->Slots[Table->ConfirmedSlots[Position]].Index];
+}
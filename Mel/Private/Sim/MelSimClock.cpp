@@ -0,0 +1,20 @@
+#include "Sim/MelSimClock.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MelSim
+{
+    int32_t AdvanceClock(FFixedStepClock& Clock, float FrameTime)
+    {
+        if (Clock.StepTime <= 0.0f)
+            return 0;
+
+        const double StepTime = Clock.StepTime;
+        const double MaxBacklog = StepTime * std::max(Clock.MaxStepsPerFrame, 1);
+        Clock.Accumulator = std::min(Clock.Accumulator + std::max(FrameTime, 0.0f), MaxBacklog);
+
+        const int32_t NumSteps = static_cast<int32_t>(std::floor(Clock.Accumulator / StepTime));
+        Clock.Accumulator = std::max(Clock.Accumulator - NumSteps * StepTime, 0.0);
+        return NumSteps;
+    }
+}
@@ -0,0 +1,389 @@
+#include "Sim/MelSimEngagement.h"
+#include <algorithm>
+#include <limits>
+
+namespace MelSim
+{
+    int32_t FEngagement::AddMissile(const FVec3& LaunchPoint, const FVec3& TargetPoint, const FMissileParams& Params)
+    {
+        ++Stats.MissilesLaunched;
+        Record(EReplayEventType::Missile, LaunchPoint, TargetPoint);
+        return Missiles.Add(MakeMissile(LaunchPoint, TargetPoint, Params), Params);
+    }
+
+    int32_t FEngagement::AddRadar(const FVec3& Location, const FRadarParams& Params)
+    {
+        FRadarState Radar;
+        Radar.Position = Location;
+        Radar.Params = Params;
+        Radars.push_back(Radar);
+        Record(EReplayEventType::Radar, Location, FVec3());
+        return static_cast<int32_t>(Radars.size()) - 1;
+    }
+
+    int32_t FEngagement::AddBattery(const FVec3& Location, int32_t RadarIndex, const FBatteryParams& Params)
+    {
+        FBatteryState Battery;
+        Battery.Position = Location;
+        Battery.RadarIndex = RadarIndex;
+        Batteries.push_back(Battery);
+        BatteryParams.push_back(Params);
+        Record(EReplayEventType::Battery, Location, FVec3());
+        return static_cast<int32_t>(Batteries.size()) - 1;
+    }
+
+    void FEngagement::Record(EReplayEventType Type, const FVec3& Position, const FVec3& Target)
+    {
+        if (!Recorder)
+            return;
+
+        FReplayEvent Event;
+        Event.Step = Stats.Steps;
+        Event.Type = Type;
+        Event.Position = Position;
+        Event.Target = Target;
+        Recorder->Add(Event);
+    }
+
+    void FEngagement::Step(float Dt)
+    {
+        StepMissiles(Dt);
+        StepRadars(Dt);
+        StepBatteries(Dt);
+        StepProjectiles(Dt);
+
+        Time += Dt;
+        ++Stats.Steps;
+    }
+
+    void FEngagement::Run(float Dt, float MaxTime)
+    {
+        while (HasLiveMissiles() && Time < MaxTime)
+        {
+            Step(Dt);
+        }
+    }
+
+    void FEngagement::KillMissile(int32_t MissileId)
+    {
+        Missiles.Remove(MissileId);
+    }
+
+    void FEngagement::StepMissiles(float Dt)
+    {
+        Missiles.Step(Dt);
+
+        // Обратный порядок: удаление переносит последний элемент на место удаленного
+        for (int32_t Index = Missiles.Num() - 1; Index >= 0; --Index)
+        {
+            if (Missiles.HasReachedTarget(Index))
+            {
+                KillMissile(Missiles.GetId(Index));
+                ++Stats.MissilesImpacted;
+            }
+        }
+    }
+
+    void FEngagement::StepRadars(float Dt)
+    {
+        for (FRadarState& Radar : Radars)
+        {
+            const FRadarParams& Params = Radar.Params;
+
+            // Обновить треки всех ракет, попавших в сектор. Для проверки сектора положения
+            // отматываются на Age назад - к моменту под-скана; трек получает только текущее положение.
+            auto Detect = [this, &Radar, &Params](float Age, auto&& IsInSector)
+            {
+                for (int32_t Index = 0; Index < Missiles.Num(); ++Index)
+                {
+                    const FVec3 Position = Missiles.GetPosition(Index);
+                    const FVec3 ScanPosition = Position - Missiles.GetVelocity(Index) * Age;
+                    if (!IsInHeightRange(Params, ScanPosition) || !IsInSector(ScanPosition))
+                        continue;
+
+                    const int32_t MissileId = Missiles.GetId(Index);
+                    if (MissileId >= static_cast<int32_t>(Radar.TrackByMissileId.size()))
+                    {
+                        Radar.TrackByMissileId.resize(MissileId + 1, -1);
+                    }
+
+                    int32_t& TrackIndex = Radar.TrackByMissileId[MissileId];
+                    if (TrackIndex < 0)
+                    {
+                        FTrack NewTrack;
+                        NewTrack.MissileId = MissileId;
+                        TrackIndex = static_cast<int32_t>(Radar.Tracks.size());
+                        Radar.Tracks.push_back(NewTrack);
+                    }
+
+                    FTrack& Track = Radar.Tracks[TrackIndex];
+                    if (ApplyDetection(Params, Radar.Position, Track, Position, Time) && !Track.bConfirmed)
+                    {
+                        PendingConfirmations.push_back(MissileId);
+                    }
+                }
+            };
+
+            if (Params.bSweptScan)
+            {
+                FSweepInterval Intervals[MaxSubScansPerStep];
+                const int32_t NumIntervals = AdvanceSweep(Params, Radar.Sweep, Dt, Intervals);
+                Radar.ScanAngle = GetBeamAngle(Params, Radar.Sweep);
+
+                for (int32_t IntervalIndex = 0; IntervalIndex < NumIntervals; ++IntervalIndex)
+                {
+                    const FSweptSectorTest Sector(Params, Radar.Position, Intervals[IntervalIndex]);
+                    Detect(Intervals[IntervalIndex].Age, [&Sector](const FVec3& Position) { return Sector.Contains(Position); });
+                }
+            }
+            else
+            {
+                Radar.ScanAngle = AdvanceScanAngle(Radar.ScanAngle, Params.ScanSpeed, Dt);
+
+                Radar.TimeSinceLastScan += Dt;
+                if (Radar.TimeSinceLastScan >= Params.ScanInterval)
+                {
+                    Radar.TimeSinceLastScan = 0.0f;
+                    Detect(0.0f, [&Radar, &Params](const FVec3& Position)
+                    {
+                        return IsInScanSector(Params, Radar.Position, Radar.ScanAngle, Position);
+                    });
+                }
+            }
+        }
+
+        ConfirmTracks();
+
+        // Очистка после сканов всех радаров
+        for (FRadarState& Radar : Radars)
+        {
+            const FRadarParams& Params = Radar.Params;
+
+            // Удаляем треки без обнаружений; оставшиеся сдвигаются с сохранением порядка и индекса
+            size_t NumKept = 0;
+            for (size_t TrackIndex = 0; TrackIndex < Radar.Tracks.size(); ++TrackIndex)
+            {
+                FTrack& Track = Radar.Tracks[TrackIndex];
+                if (Time - Track.LastDetectionTime > Params.TrackTimeout)
+                {
+                    Radar.TrackByMissileId[Track.MissileId] = -1;
+                    continue;
+                }
+
+                Radar.TrackByMissileId[Track.MissileId] = static_cast<int32_t>(NumKept);
+                if (NumKept != TrackIndex)
+                {
+                    Radar.Tracks[NumKept] = Track;
+                }
+                ++NumKept;
+            }
+            Radar.Tracks.resize(NumKept);
+        }
+    }
+
+    void FEngagement::ConfirmTracks()
+    {
+        for (const int32_t MissileId : PendingConfirmations)
+        {
+            // Треки ракеты во всех радарах: сумма обнаружений, наименьший порог, уже подтвержденные
+            int32_t DetectionCount = 0;
+            int32_t ConfirmDetections = std::numeric_limits<int32_t>::max();
+            bool bConfirmed = false;
+            for (const FRadarState& Radar : Radars)
+            {
+                const int32_t TrackIndex = MissileId < static_cast<int32_t>(Radar.TrackByMissileId.size()) ? Radar.TrackByMissileId[MissileId] : -1;
+                if (TrackIndex < 0)
+                    continue;
+
+                DetectionCount += Radar.Tracks[TrackIndex].DetectionCount;
+                ConfirmDetections = std::min(ConfirmDetections, Radar.Params.ConfirmDetections);
+                bConfirmed = bConfirmed || Radar.Tracks[TrackIndex].bConfirmed;
+            }
+
+            if (!bConfirmed && DetectionCount < ConfirmDetections)
+                continue;
+
+            for (FRadarState& Radar : Radars)
+            {
+                const int32_t TrackIndex = MissileId < static_cast<int32_t>(Radar.TrackByMissileId.size()) ? Radar.TrackByMissileId[MissileId] : -1;
+                if (TrackIndex >= 0)
+                {
+                    Radar.Tracks[TrackIndex].bConfirmed = true;
+                }
+            }
+        }
+        PendingConfirmations.clear();
+    }
+
+    void FEngagement::StepBatteries(float Dt)
+    {
+        for (FBatteryState& Battery : Batteries)
+        {
+            Battery.TimeSinceLastFire += Dt;
+        }
+
+        // Цели распределяются с постоянным периодом, а не каждый шаг
+        TimeSinceAssignment += Dt;
+        if (TimeSinceAssignment < FireControlInterval)
+            return;
+
+        TimeSinceAssignment -= FireControlInterval;
+        AssignTargets();
+    }
+
+    void FEngagement::AssignTargets()
+    {
+        Assignment.Reset();
+        Targets.clear();
+        TargetByMissileIndex.assign(Missiles.Num(), -1);
+
+        // Ассоциация по ракете: подтвержденные треки разных радаров одной ракеты дают одну цель
+        for (const FRadarState& Radar : Radars)
+        {
+            for (const FTrack& Track : Radar.Tracks)
+            {
+                const int32_t MissileIndex = Missiles.GetIndex(Track.MissileId);
+                if (!Track.bConfirmed || MissileIndex < 0)
+                    continue;
+
+                int32_t& TargetIndex = TargetByMissileIndex[MissileIndex];
+                if (TargetIndex < 0)
+                {
+                    TargetIndex = static_cast<int32_t>(Targets.size());
+                    Targets.emplace_back();
+                    Targets.back().MissileId = Track.MissileId;
+                }
+
+                FFusedTarget& Target = Targets[TargetIndex];
+                Target.ThreatLevel = std::max(Target.ThreatLevel, Track.ThreatLevel);
+                Target.Fusion.Add(Track.Estimate, Time);
+            }
+        }
+
+        for (FFusedTarget& Target : Targets)
+        {
+            Target.Position = Target.Fusion.GetPosition();
+            Target.Velocity = Target.Fusion.GetVelocity();
+        }
+
+        if (Targets.empty())
+            return;
+
+        // Снаряды в полете уже снижают выживаемость своих целей
+        TargetSurvivals.assign(Targets.size(), 1.0f);
+        for (const FProjectileState& Projectile : Projectiles)
+        {
+            const int32_t MissileIndex = Missiles.GetIndex(Projectile.TargetId);
+            if (MissileIndex >= 0 && TargetByMissileIndex[MissileIndex] >= 0)
+            {
+                TargetSurvivals[TargetByMissileIndex[MissileIndex]] *= 1.0f - Projectile.KillProbability;
+            }
+        }
+
+        for (size_t Target = 0; Target < Targets.size(); ++Target)
+        {
+            Assignment.AddTarget(Targets[Target].ThreatLevel, TargetSurvivals[Target]);
+        }
+
+        // Варианты выстрела готовых батарей по целям в радиусе действия с решением встречи.
+        // Дальность и встреча считаются по оценке слитого трека, от ракеты берется только профиль фаз.
+        ShooterBatteries.clear();
+        OptionIntercepts.clear();
+        for (size_t Index = 0; Index < Batteries.size(); ++Index)
+        {
+            const FBatteryState& Battery = Batteries[Index];
+            const FBatteryParams& Params = BatteryParams[Index];
+            if (Battery.TimeSinceLastFire < Params.FireInterval)
+                continue;
+
+            const int32_t Shooter = Assignment.AddShooter();
+            ShooterBatteries.push_back(static_cast<int32_t>(Index));
+
+            const float RangeSquared = Params.DetectionRadius * Params.DetectionRadius;
+            for (size_t Target = 0; Target < Targets.size(); ++Target)
+            {
+                const FFusedTarget& Fused = Targets[Target];
+                if (FVec3::DistSquared(Fused.Position, Battery.Position) >= RangeSquared)
+                    continue;
+
+                const int32_t MissileIndex = Missiles.GetIndex(Fused.MissileId);
+                FMissileState MissileState = Missiles.GetState(MissileIndex);
+                MissileState.Position = Fused.Position;
+                MissileState.Velocity = Fused.Velocity;
+
+                FInterceptSolution Intercept;
+                if (!SolveMissileIntercept(Battery.Position, Params.ProjectileSpeed, MissileState,
+                                           Missiles.GetParams(MissileIndex), Params.MaxInterceptTime, Intercept))
+                    continue;
+
+                Assignment.AddOption(Shooter, static_cast<int32_t>(Target),
+                    EstimateKillProbability(Params.KillProbability, Intercept.Time, Params.MaxInterceptTime));
+                OptionIntercepts.push_back(Intercept);
+            }
+        }
+
+        Assignment.Solve(MinKillGain);
+
+        // Пуск в точку встречи назначенной цели
+        for (int32_t Shooter = 0; Shooter < Assignment.NumShooters(); ++Shooter)
+        {
+            const int32_t OptionIndex = Assignment.GetAssignedOption(Shooter);
+            if (OptionIndex < 0)
+                continue;
+
+            const FWeaponTargetAssignment::FOption& Option = Assignment.GetOption(OptionIndex);
+            FBatteryState& Battery = Batteries[ShooterBatteries[Shooter]];
+            const FBatteryParams& Params = BatteryParams[ShooterBatteries[Shooter]];
+            const int32_t MissileId = Targets[Option.Target].MissileId;
+
+            Record(EReplayEventType::Fire, Battery.Position, Missiles.GetPosition(Missiles.GetIndex(MissileId)));
+            FProjectileState Projectile = MakeProjectile(Battery.Position, OptionIntercepts[OptionIndex].Direction, MissileId,
+                                                         Params.InitialForwardDistance, Params.ProjectileSpeed);
+            Projectile.KillProbability = Option.KillProbability;
+            Projectiles.push_back(Projectile);
+            Battery.TimeSinceLastFire = 0.0f;
+            ++Stats.ProjectilesFired;
+        }
+    }
+
+    void FEngagement::StepProjectiles(float Dt)
+    {
+        for (FProjectileState& Projectile : Projectiles)
+        {
+            const int32_t TargetIndex = Missiles.GetIndex(Projectile.TargetId);
+            const FVec3 TargetPosition = TargetIndex >= 0 ? Missiles.GetPosition(TargetIndex) : FVec3();
+            const FVec3 TargetVelocity = TargetIndex >= 0 ? Missiles.GetVelocity(TargetIndex) : FVec3();
+
+            const EProjectileResult Result = StepProjectile(Projectile,
+                TargetIndex >= 0 ? &TargetPosition : nullptr, TargetIndex >= 0 ? &TargetVelocity : nullptr, Dt);
+
+            if (Result == EProjectileResult::HitTarget)
+            {
+                KillMissile(Projectile.TargetId);
+                ++Stats.MissilesIntercepted;
+                Projectile.bAlive = false;
+                continue;
+            }
+
+            // Подрыв по близости от любой ракеты на всем шаге
+            for (int32_t Index = 0; Index < Missiles.Num(); ++Index)
+            {
+                if (SweptProximity(Projectile, Missiles.GetPosition(Index), Missiles.GetVelocity(Index), Dt, ProjectileProximityRadius))
+                {
+                    KillMissile(Missiles.GetId(Index));
+                    ++Stats.MissilesIntercepted;
+                    Projectile.bAlive = false;
+                    break;
+                }
+            }
+
+            if (Projectile.FlightTime > MaxProjectileFlightTime)
+            {
+                Projectile.bAlive = false;
+            }
+        }
+
+        Projectiles.erase(std::remove_if(Projectiles.begin(), Projectiles.end(),
+            [](const FProjectileState& Projectile) { return !Projectile.bAlive; }), Projectiles.end());
+    }
+}
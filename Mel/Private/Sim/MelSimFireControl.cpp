@@ -0,0 +1,78 @@
+#include "Sim/MelSimFireControl.h"
+#include "Sim/MelSimMath.h"
+
+namespace MelSim
+{
+    float EstimateKillProbability(float KillProbability, float InterceptTime, float MaxInterceptTime)
+    {
+        if (MaxInterceptTime <= 0.0f)
+            return 0.0f;
+
+        return KillProbability * Clamp(1.0f - InterceptTime / MaxInterceptTime, 0.0f, 1.0f);
+    }
+
+    void FWeaponTargetAssignment::Reset()
+    {
+        TargetValues.clear();
+        TargetSurvivals.clear();
+        Options.clear();
+        AssignedOptions.clear();
+    }
+
+    int32_t FWeaponTargetAssignment::AddTarget(float Value, float Survival)
+    {
+        TargetValues.push_back(Value);
+        TargetSurvivals.push_back(Survival);
+        return NumTargets() - 1;
+    }
+
+    int32_t FWeaponTargetAssignment::AddShooter()
+    {
+        AssignedOptions.push_back(-1);
+        return NumShooters() - 1;
+    }
+
+    int32_t FWeaponTargetAssignment::AddOption(int32_t Shooter, int32_t Target, float KillProbability)
+    {
+        FOption Option;
+        Option.Shooter = Shooter;
+        Option.Target = Target;
+        Option.KillProbability = KillProbability;
+        Options.push_back(Option);
+        return NumOptions() - 1;
+    }
+
+    void FWeaponTargetAssignment::Solve(float MinKillGain)
+    {
+        // Не больше одного назначения на батарею: раундов не больше числа батарей
+        for (int32_t Round = 0; Round < NumShooters(); ++Round)
+        {
+            int32_t BestOption = -1;
+            float BestScore = -1.0f;
+            for (int32_t OptionIndex = 0; OptionIndex < NumOptions(); ++OptionIndex)
+            {
+                const FOption& Option = Options[OptionIndex];
+                if (AssignedOptions[Option.Shooter] >= 0 || Option.KillProbability <= 0.0f)
+                    continue;
+
+                const float KillGain = TargetSurvivals[Option.Target] * Option.KillProbability;
+                if (KillGain < MinKillGain)
+                    continue;
+
+                const float Score = TargetValues[Option.Target] * KillGain;
+                if (Score > BestScore)
+                {
+                    BestScore = Score;
+                    BestOption = OptionIndex;
+                }
+            }
+
+            if (BestOption < 0)
+                break;
+
+            const FOption& Option = Options[BestOption];
+            AssignedOptions[Option.Shooter] = BestOption;
+            TargetSurvivals[Option.Target] *= 1.0f - Option.KillProbability;
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include "Sim/MelSimIntercept.h"
+#include <cmath>
+
+namespace MelSim
+{
+    namespace
+    {
+        // Наименьший корень |Offset + Velocity t| = Speed t на отрезке [MinTime, MaxTime]
+        bool SolveClosing(const FVec3& Offset, const FVec3& Velocity, float Speed, float MinTime, float MaxTime, float& OutTime)
+        {
+            // (V.V - s^2) t^2 + 2 (D.V) t + D.D = 0
+            const float A = FVec3::Dot(Velocity, Velocity) - Speed * Speed;
+            const float B = 2.0f * FVec3::Dot(Offset, Velocity);
+            const float C = FVec3::Dot(Offset, Offset);
+
+            float Roots[2];
+            int32_t NumRoots = 0;
+            if (std::fabs(A) < KindaSmallNumber)
+            {
+                // Скорости равны: уравнение линейное
+                if (std::fabs(B) < SmallNumber)
+                    return false;
+                Roots[NumRoots++] = -C / B;
+            }
+            else
+            {
+                const float Discriminant = B * B - 4.0f * A * C;
+                if (Discriminant < 0.0f)
+                    return false;
+
+                // Устойчивая форма корней: без вычитания близких чисел
+                const float Q = -0.5f * (B + std::copysign(std::sqrt(Discriminant), B));
+                Roots[NumRoots++] = Q / A;
+                if (std::fabs(Q) > SmallNumber)
+                {
+                    Roots[NumRoots++] = C / Q;
+                }
+            }
+
+            bool bFound = false;
+            for (int32_t i = 0; i < NumRoots; ++i)
+            {
+                if (Roots[i] >= MinTime && Roots[i] <= MaxTime && (!bFound || Roots[i] < OutTime))
+                {
+                    OutTime = Roots[i];
+                    bFound = true;
+                }
+            }
+            return bFound;
+        }
+
+        void MakeSolution(const FVec3& Shooter, const FVec3& AimPoint, float Time, FInterceptSolution& OutSolution)
+        {
+            OutSolution.AimPoint = AimPoint;
+            OutSolution.Direction = (AimPoint - Shooter).GetSafeNormal();
+            OutSolution.Time = Time;
+        }
+    }
+
+    bool SolveIntercept(const FVec3& Shooter, float Speed, const FVec3& TargetPosition, const FVec3& TargetVelocity,
+                        FInterceptSolution& OutSolution)
+    {
+        if (Speed <= 0.0f)
+            return false;
+
+        float Time = 0.0f;
+        if (!SolveClosing(TargetPosition - Shooter, TargetVelocity, Speed, 0.0f, HUGE_VALF, Time))
+            return false;
+
+        MakeSolution(Shooter, TargetPosition + TargetVelocity * Time, Time, OutSolution);
+        return true;
+    }
+
+    bool SolveMissileIntercept(const FVec3& Shooter, float Speed, const FMissileState& Missile, const FMissileParams& Params,
+                               float MaxTime, FInterceptSolution& OutSolution, float PredictionStep)
+    {
+        if (Speed <= 0.0f || PredictionStep <= 0.0f)
+            return false;
+
+        FMissileState State = Missile;
+        for (int32_t Segment = 0; static_cast<float>(Segment) * PredictionStep < MaxTime; ++Segment)
+        {
+            const float StartTime = static_cast<float>(Segment) * PredictionStep;
+            const FVec3 StartPosition = State.Position;
+            StepMissile(State, Params, PredictionStep);
+            const FVec3 SegmentVelocity = (State.Position - StartPosition) * (1.0f / PredictionStep);
+
+            // На отрезке положение ракеты StartPosition + SegmentVelocity (t - StartTime)
+            const FVec3 Offset = StartPosition - SegmentVelocity * StartTime - Shooter;
+            const float EndTime = StartTime + PredictionStep;
+            float Time = 0.0f;
+            if (SolveClosing(Offset, SegmentVelocity, Speed, StartTime, EndTime < MaxTime ? EndTime : MaxTime, Time))
+            {
+                MakeSolution(Shooter, StartPosition + SegmentVelocity * (Time - StartTime), Time, OutSolution);
+                return true;
+            }
+
+            if (HasReachedTarget(State, Params))
+                return false;
+        }
+        return false;
+    }
+}
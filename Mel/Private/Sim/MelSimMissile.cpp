@@ -0,0 +1,79 @@
+#include "Sim/MelSimMissile.h"
+
+namespace MelSim
+{
+    FMissileState MakeMissile(const FVec3& LaunchPoint, const FVec3& TargetPoint, const FMissileParams& Params)
+    {
+        FMissileState State;
+        State.Position = LaunchPoint;
+        State.TargetPoint = TargetPoint;
+        State.Velocity = FVec3(0.0f, 0.0f, Params.Speed);
+        State.Phase = EMissilePhase::Ascending;
+        State.TransitionElapsed = 0.0f;
+        return State;
+    }
+
+    bool StepMissile(FMissileState& State, const FMissileParams& Params, float Dt)
+    {
+        const EMissilePhase PreviousPhase = State.Phase;
+
+        switch (State.Phase)
+        {
+            case EMissilePhase::Ascending:
+                State.Velocity = FVec3(0.0f, 0.0f, Params.Speed);
+                if (State.Position.Z >= Params.TargetHeight)
+                {
+                    State.Phase = EMissilePhase::Transition;
+                    State.TransitionElapsed = 0.0f;
+                    State.TargetDirection = (State.TargetPoint - State.Position).GetSafeNormal();
+                }
+                break;
+
+            case EMissilePhase::Transition:
+                State.TransitionElapsed += Dt;
+                if (State.TransitionElapsed >= Params.TransitionTime)
+                {
+                    // Скорость сохраняется с последнего шага перехода
+                    State.Phase = EMissilePhase::Horizontal;
+                    State.HorizontalStartPoint = State.Position;
+                    const FVec3 DirectionToTarget = (State.TargetPoint - State.HorizontalStartPoint).GetSafeNormal();
+                    State.HorizontalEndPoint = State.HorizontalStartPoint + DirectionToTarget * Params.HorizontalDistance;
+                    State.HorizontalEndPoint.Z = Params.HorizontalHeight;
+                }
+                else
+                {
+                    const float Alpha = SmoothStep01(State.TransitionElapsed / Params.TransitionTime);
+                    const FVec3 CurrentDirection = FVec3::Lerp(FVec3(0.0f, 0.0f, 1.0f), State.TargetDirection, Alpha);
+                    State.Velocity = CurrentDirection * Params.Speed;
+                }
+                break;
+
+            case EMissilePhase::Horizontal:
+            {
+                const FVec3 ToHorizontalEnd = State.HorizontalEndPoint - State.Position;
+                State.Velocity = ToHorizontalEnd.GetSafeNormal() * Params.Speed;
+                if (ToHorizontalEnd.Size() < Params.HorizontalArrivalTolerance)
+                {
+                    State.Phase = EMissilePhase::Descent;
+                }
+                break;
+            }
+
+            case EMissilePhase::Descent:
+                State.Velocity = (State.TargetPoint - State.Position).GetSafeNormal() * Params.Speed;
+                break;
+        }
+
+        State.Position += State.Velocity * Dt;
+        return State.Phase != PreviousPhase;
+    }
+
+    bool HasReachedTarget(const FMissileState& State, const FMissileParams& Params)
+    {
+        if (State.Phase != EMissilePhase::Descent)
+            return false;
+
+        return State.Position.Z <= State.TargetPoint.Z
+            || FVec3::DistSquared(State.Position, State.TargetPoint) < Params.ImpactTolerance * Params.ImpactTolerance;
+    }
+}
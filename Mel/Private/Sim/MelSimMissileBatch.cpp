@@ -0,0 +1,331 @@
+#include "Sim/MelSimMissileBatch.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <emmintrin.h>
+    #define MELSIM_WITH_SSE 1
+#else
+    #define MELSIM_WITH_SSE 0
+#endif
+
+namespace MelSim
+{
+    namespace
+    {
+        template <typename T>
+        void MoveLast(std::vector<T>& Values, int32_t Index)
+        {
+            Values[Index] = Values.back();
+            Values.pop_back();
+        }
+    }
+
+    int32_t FMissileBatch::Add(const FMissileState& State, const FMissileParams& Params)
+    {
+        const int32_t Index = Num();
+
+        int32_t Id;
+        if (!FreeIds.empty())
+        {
+            Id = FreeIds.back();
+            FreeIds.pop_back();
+            IdToIndex[Id] = Index;
+        }
+        else
+        {
+            Id = static_cast<int32_t>(IdToIndex.size());
+            IdToIndex.push_back(Index);
+        }
+        IndexToId.push_back(Id);
+
+        for (std::vector<float>* Values : { &PosX, &PosY, &PosZ, &VelX, &VelY, &VelZ, &TargetX, &TargetY, &TargetZ,
+                                            &DirX, &DirY, &DirZ, &HorizontalStartX, &HorizontalStartY, &HorizontalStartZ,
+                                            &HorizontalEndX, &HorizontalEndY, &HorizontalEndZ, &TransitionElapsed })
+        {
+            Values->push_back(0.0f);
+        }
+        Phase.push_back(0);
+
+        Speed.push_back(Params.Speed);
+        TargetHeight.push_back(Params.TargetHeight);
+        HorizontalHeight.push_back(Params.HorizontalHeight);
+        HorizontalDistance.push_back(Params.HorizontalDistance);
+        TransitionTime.push_back(Params.TransitionTime);
+        ArrivalTolerance.push_back(Params.HorizontalArrivalTolerance);
+        ImpactTolerance.push_back(Params.ImpactTolerance);
+
+        SetState(Index, State);
+        return Id;
+    }
+
+    void FMissileBatch::Remove(int32_t Id)
+    {
+        if (!Contains(Id))
+            return;
+
+        const int32_t Index = IdToIndex[Id];
+        const int32_t LastId = IndexToId.back();
+
+        for (std::vector<float>* Values : { &PosX, &PosY, &PosZ, &VelX, &VelY, &VelZ, &TargetX, &TargetY, &TargetZ,
+                                            &DirX, &DirY, &DirZ, &HorizontalStartX, &HorizontalStartY, &HorizontalStartZ,
+                                            &HorizontalEndX, &HorizontalEndY, &HorizontalEndZ, &TransitionElapsed,
+                                            &Speed, &TargetHeight, &HorizontalHeight, &HorizontalDistance,
+                                            &TransitionTime, &ArrivalTolerance, &ImpactTolerance })
+        {
+            MoveLast(*Values, Index);
+        }
+        MoveLast(Phase, Index);
+        MoveLast(IndexToId, Index);
+
+        IdToIndex[LastId] = Index;
+        IdToIndex[Id] = -1;
+        FreeIds.push_back(Id);
+    }
+
+    bool FMissileBatch::Contains(int32_t Id) const
+    {
+        return Id >= 0 && Id < static_cast<int32_t>(IdToIndex.size()) && IdToIndex[Id] >= 0;
+    }
+
+    void FMissileBatch::SetPosition(int32_t Index, const FVec3& Position)
+    {
+        PosX[Index] = Position.X;
+        PosY[Index] = Position.Y;
+        PosZ[Index] = Position.Z;
+    }
+
+    FMissileState FMissileBatch::GetState(int32_t Index) const
+    {
+        FMissileState State;
+        State.Position = GetPosition(Index);
+        State.Velocity = GetVelocity(Index);
+        State.TargetPoint = FVec3(TargetX[Index], TargetY[Index], TargetZ[Index]);
+        State.TargetDirection = FVec3(DirX[Index], DirY[Index], DirZ[Index]);
+        State.HorizontalStartPoint = FVec3(HorizontalStartX[Index], HorizontalStartY[Index], HorizontalStartZ[Index]);
+        State.HorizontalEndPoint = FVec3(HorizontalEndX[Index], HorizontalEndY[Index], HorizontalEndZ[Index]);
+        State.TransitionElapsed = TransitionElapsed[Index];
+        State.Phase = GetPhase(Index);
+        return State;
+    }
+
+    FMissileParams FMissileBatch::GetParams(int32_t Index) const
+    {
+        FMissileParams Params;
+        Params.Speed = Speed[Index];
+        Params.TargetHeight = TargetHeight[Index];
+        Params.HorizontalHeight = HorizontalHeight[Index];
+        Params.HorizontalDistance = HorizontalDistance[Index];
+        Params.TransitionTime = TransitionTime[Index];
+        Params.HorizontalArrivalTolerance = ArrivalTolerance[Index];
+        Params.ImpactTolerance = ImpactTolerance[Index];
+        return Params;
+    }
+
+    void FMissileBatch::SetState(int32_t Index, const FMissileState& State)
+    {
+        SetPosition(Index, State.Position);
+        VelX[Index] = State.Velocity.X;
+        VelY[Index] = State.Velocity.Y;
+        VelZ[Index] = State.Velocity.Z;
+        TargetX[Index] = State.TargetPoint.X;
+        TargetY[Index] = State.TargetPoint.Y;
+        TargetZ[Index] = State.TargetPoint.Z;
+        DirX[Index] = State.TargetDirection.X;
+        DirY[Index] = State.TargetDirection.Y;
+        DirZ[Index] = State.TargetDirection.Z;
+        HorizontalStartX[Index] = State.HorizontalStartPoint.X;
+        HorizontalStartY[Index] = State.HorizontalStartPoint.Y;
+        HorizontalStartZ[Index] = State.HorizontalStartPoint.Z;
+        HorizontalEndX[Index] = State.HorizontalEndPoint.X;
+        HorizontalEndY[Index] = State.HorizontalEndPoint.Y;
+        HorizontalEndZ[Index] = State.HorizontalEndPoint.Z;
+        TransitionElapsed[Index] = State.TransitionElapsed;
+        Phase[Index] = static_cast<int32_t>(State.Phase);
+    }
+
+    bool FMissileBatch::HasReachedTarget(int32_t Index) const
+    {
+        if (Phase[Index] != static_cast<int32_t>(EMissilePhase::Descent))
+            return false;
+
+        const FVec3 ToTarget = FVec3(TargetX[Index], TargetY[Index], TargetZ[Index]) - GetPosition(Index);
+        return ToTarget.Z >= 0.0f || ToTarget.SizeSquared() < ImpactTolerance[Index] * ImpactTolerance[Index];
+    }
+
+    void FMissileBatch::Step(float Dt)
+    {
+        const int32_t Count = Num();
+        int32_t Index = 0;
+
+#if MELSIM_WITH_SSE
+        for (; Index + 4 <= Count; Index += 4)
+        {
+            StepSimd4(Index, Dt);
+        }
+#endif
+
+        for (; Index < Count; ++Index)
+        {
+            StepScalar(Index, Dt);
+        }
+    }
+
+    void FMissileBatch::StepScalar(int32_t Index, float Dt)
+    {
+        FMissileState State = GetState(Index);
+        StepMissile(State, GetParams(Index), Dt);
+        SetState(Index, State);
+    }
+
+    void FMissileBatch::ApplyPhaseChange(int32_t Index)
+    {
+        // Позиция еще не проинтегрирована: переходы считаются от точки начала шага, как в StepMissile
+        const FVec3 Position = GetPosition(Index);
+        const FVec3 TargetPoint(TargetX[Index], TargetY[Index], TargetZ[Index]);
+
+        switch (static_cast<EMissilePhase>(Phase[Index]))
+        {
+            case EMissilePhase::Ascending:
+            {
+                const FVec3 Direction = (TargetPoint - Position).GetSafeNormal();
+                DirX[Index] = Direction.X;
+                DirY[Index] = Direction.Y;
+                DirZ[Index] = Direction.Z;
+                TransitionElapsed[Index] = 0.0f;
+                Phase[Index] = static_cast<int32_t>(EMissilePhase::Transition);
+                break;
+            }
+
+            case EMissilePhase::Transition:
+            {
+                const FVec3 Direction = (TargetPoint - Position).GetSafeNormal();
+                const FVec3 End = Position + Direction * HorizontalDistance[Index];
+                HorizontalStartX[Index] = Position.X;
+                HorizontalStartY[Index] = Position.Y;
+                HorizontalStartZ[Index] = Position.Z;
+                HorizontalEndX[Index] = End.X;
+                HorizontalEndY[Index] = End.Y;
+                HorizontalEndZ[Index] = HorizontalHeight[Index];
+                Phase[Index] = static_cast<int32_t>(EMissilePhase::Horizontal);
+                break;
+            }
+
+            case EMissilePhase::Horizontal:
+                Phase[Index] = static_cast<int32_t>(EMissilePhase::Descent);
+                break;
+
+            case EMissilePhase::Descent:
+                break;
+        }
+    }
+
+#if MELSIM_WITH_SSE
+    namespace
+    {
+        inline __m128 Select(__m128 Mask, __m128 A, __m128 B)
+        {
+            return _mm_or_ps(_mm_and_ps(Mask, A), _mm_andnot_ps(Mask, B));
+        }
+    }
+
+    void FMissileBatch::StepSimd4(int32_t Index, float Dt)
+    {
+        const __m128 VDt = _mm_set1_ps(Dt);
+        const __m128 Zero = _mm_setzero_ps();
+        const __m128 One = _mm_set1_ps(1.0f);
+
+        const __m128i Phases = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Phase[Index]));
+        const __m128 IsAscending = _mm_castsi128_ps(_mm_cmpeq_epi32(Phases, _mm_set1_epi32(static_cast<int32_t>(EMissilePhase::Ascending))));
+        const __m128 IsTransition = _mm_castsi128_ps(_mm_cmpeq_epi32(Phases, _mm_set1_epi32(static_cast<int32_t>(EMissilePhase::Transition))));
+        const __m128 IsHorizontal = _mm_castsi128_ps(_mm_cmpeq_epi32(Phases, _mm_set1_epi32(static_cast<int32_t>(EMissilePhase::Horizontal))));
+
+        const __m128 Px = _mm_loadu_ps(&PosX[Index]);
+        const __m128 Py = _mm_loadu_ps(&PosY[Index]);
+        const __m128 Pz = _mm_loadu_ps(&PosZ[Index]);
+        const __m128 OldVx = _mm_loadu_ps(&VelX[Index]);
+        const __m128 OldVy = _mm_loadu_ps(&VelY[Index]);
+        const __m128 OldVz = _mm_loadu_ps(&VelZ[Index]);
+        const __m128 S = _mm_loadu_ps(&Speed[Index]);
+
+        const __m128 IsSeeking = _mm_andnot_ps(_mm_or_ps(IsAscending, IsTransition), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        const bool bAnySeeking = _mm_movemask_ps(IsSeeking) != 0;
+        const bool bAnyTransition = _mm_movemask_ps(IsTransition) != 0;
+
+        // Horizontal и Descent: полет к точке (конец горизонтального участка или цель)
+        __m128 SeekVx = Zero, SeekVy = Zero, SeekVz = Zero, Length = Zero;
+        if (bAnySeeking)
+        {
+            const __m128 Gx = Select(IsHorizontal, _mm_loadu_ps(&HorizontalEndX[Index]), _mm_loadu_ps(&TargetX[Index]));
+            const __m128 Gy = Select(IsHorizontal, _mm_loadu_ps(&HorizontalEndY[Index]), _mm_loadu_ps(&TargetY[Index]));
+            const __m128 Gz = Select(IsHorizontal, _mm_loadu_ps(&HorizontalEndZ[Index]), _mm_loadu_ps(&TargetZ[Index]));
+            const __m128 Dx = _mm_sub_ps(Gx, Px);
+            const __m128 Dy = _mm_sub_ps(Gy, Py);
+            const __m128 Dz = _mm_sub_ps(Gz, Pz);
+            const __m128 LengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Dx, Dx), _mm_mul_ps(Dy, Dy)), _mm_mul_ps(Dz, Dz));
+            Length = _mm_sqrt_ps(LengthSquared);
+            const __m128 InvLength = _mm_and_ps(_mm_cmpgt_ps(LengthSquared, _mm_set1_ps(SmallNumber)), _mm_div_ps(One, Length));
+            SeekVx = _mm_mul_ps(_mm_mul_ps(Dx, InvLength), S);
+            SeekVy = _mm_mul_ps(_mm_mul_ps(Dy, InvLength), S);
+            SeekVz = _mm_mul_ps(_mm_mul_ps(Dz, InvLength), S);
+        }
+
+        // Transition: плавный поворот от вертикали к направлению на цель
+        const __m128 OldElapsed = _mm_loadu_ps(&TransitionElapsed[Index]);
+        __m128 Elapsed = OldElapsed;
+        __m128 TransitionDone = Zero;
+        __m128 TransitionVx = Zero, TransitionVy = Zero, TransitionVz = Zero;
+        if (bAnyTransition)
+        {
+            Elapsed = _mm_add_ps(OldElapsed, VDt);
+            const __m128 Duration = _mm_loadu_ps(&TransitionTime[Index]);
+            TransitionDone = _mm_and_ps(IsTransition, _mm_cmpge_ps(Elapsed, Duration));
+            const __m128 X = _mm_min_ps(_mm_max_ps(_mm_div_ps(Elapsed, Duration), Zero), One);
+            const __m128 Alpha = _mm_mul_ps(_mm_mul_ps(X, X), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_add_ps(X, X)));
+            const __m128 LerpVx = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&DirX[Index]), Alpha), S);
+            const __m128 LerpVy = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&DirY[Index]), Alpha), S);
+            const __m128 LerpVz = _mm_mul_ps(_mm_add_ps(One, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&DirZ[Index]), One), Alpha)), S);
+            TransitionVx = Select(TransitionDone, OldVx, LerpVx);
+            TransitionVy = Select(TransitionDone, OldVy, LerpVy);
+            TransitionVz = Select(TransitionDone, OldVz, LerpVz);
+        }
+
+        // Смены фаз
+        const __m128 AscentDone = _mm_and_ps(IsAscending, _mm_cmpge_ps(Pz, _mm_loadu_ps(&TargetHeight[Index])));
+        const __m128 HorizontalDone = _mm_and_ps(IsHorizontal, _mm_cmplt_ps(Length, _mm_loadu_ps(&ArrivalTolerance[Index])));
+
+        // Скорость по фазам: Ascending - вертикально вверх
+        const __m128 Vx = Select(IsAscending, Zero, Select(IsTransition, TransitionVx, SeekVx));
+        const __m128 Vy = Select(IsAscending, Zero, Select(IsTransition, TransitionVy, SeekVy));
+        const __m128 Vz = Select(IsAscending, S, Select(IsTransition, TransitionVz, SeekVz));
+
+        _mm_storeu_ps(&VelX[Index], Vx);
+        _mm_storeu_ps(&VelY[Index], Vy);
+        _mm_storeu_ps(&VelZ[Index], Vz);
+        _mm_storeu_ps(&TransitionElapsed[Index], Select(IsTransition, Elapsed, OldElapsed));
+
+        // Смена фазы - редкое событие, точки маршрута пересчитываются скалярно
+        const int ChangedLanes = _mm_movemask_ps(_mm_or_ps(AscentDone, _mm_or_ps(TransitionDone, HorizontalDone)));
+        if (ChangedLanes != 0)
+        {
+            for (int32_t Lane = 0; Lane < 4; ++Lane)
+            {
+                if (ChangedLanes & (1 << Lane))
+                {
+                    ApplyPhaseChange(Index + Lane);
+                }
+            }
+        }
+
+        _mm_storeu_ps(&PosX[Index], _mm_add_ps(Px, _mm_mul_ps(Vx, VDt)));
+        _mm_storeu_ps(&PosY[Index], _mm_add_ps(Py, _mm_mul_ps(Vy, VDt)));
+        _mm_storeu_ps(&PosZ[Index], _mm_add_ps(Pz, _mm_mul_ps(Vz, VDt)));
+    }
+#else
+    void FMissileBatch::StepSimd4(int32_t Index, float Dt)
+    {
+        for (int32_t Lane = 0; Lane < 4; ++Lane)
+        {
+            StepScalar(Index + Lane, Dt);
+        }
+    }
+#endif
+}
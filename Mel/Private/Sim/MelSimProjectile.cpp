@@ -0,0 +1,85 @@
+#include "Sim/MelSimProjectile.h"
+#include "Sim/MelSimIntercept.h"
+
+namespace MelSim
+{
+    FProjectileState MakeProjectile(const FVec3& Origin, const FVec3& Forward, int32_t TargetId,
+                                    float ForwardDistance, float Speed)
+    {
+        FProjectileState State;
+        State.Position = Origin;
+        State.PreviousPosition = Origin;
+        State.Forward = Forward.GetSafeNormal();
+        State.TargetId = TargetId;
+        State.ForwardDistance = ForwardDistance;
+        State.Speed = Speed;
+        return State;
+    }
+
+    EProjectileResult StepProjectile(FProjectileState& State, const FVec3* TargetPosition,
+                                     const FVec3* TargetVelocity, float Dt)
+    {
+        const FVec3 CurrentLocation = State.Position;
+        State.PreviousPosition = CurrentLocation;
+        State.FlightTime += Dt;
+
+        if (!State.bIsHoming)
+        {
+            State.Position = CurrentLocation + State.Forward * State.Speed * Dt;
+            State.TravelledDistance += (State.Position - CurrentLocation).Size();
+            if (State.TravelledDistance >= State.ForwardDistance)
+            {
+                State.bIsHoming = true;
+            }
+        }
+        else if (TargetPosition)
+        {
+            // Точка встречи с целью постоянной скорости; для равномерной цели курс больше не меняется
+            const FVec3 TargetVel = TargetVelocity ? *TargetVelocity : FVec3();
+            FInterceptSolution Intercept;
+            if (SolveIntercept(CurrentLocation, State.Speed, *TargetPosition, TargetVel, Intercept))
+            {
+                State.Forward = Intercept.Direction;
+            }
+            else
+            {
+                // Цель уходит быстрее снаряда - упреждение на время полета до текущей позиции
+                const float TimeToTarget = FVec3::Dist(CurrentLocation, *TargetPosition) / State.Speed;
+                State.Forward = (*TargetPosition + TargetVel * TimeToTarget - CurrentLocation).GetSafeNormal();
+            }
+            State.Position = CurrentLocation + State.Forward * State.Speed * Dt;
+
+            // Сближение с целью на всем шаге: цель пришла в TargetPosition за этот же шаг
+            if (SweptProximity(State, *TargetPosition, TargetVel, Dt, ProjectileHitRadius))
+            {
+                return EProjectileResult::HitTarget;
+            }
+        }
+        else
+        {
+            // Нет цели — летим прямо
+            State.Position = CurrentLocation + State.Forward * State.Speed * Dt;
+        }
+
+        return EProjectileResult::None;
+    }
+
+    float SweptClosestDistSquared(const FVec3& A0, const FVec3& A1, const FVec3& B0, const FVec3& B1, float& OutAlpha)
+    {
+        // Относительное положение D(t) = D0 + Delta t, t в [0, 1]
+        const FVec3 D0 = A0 - B0;
+        const FVec3 Delta = (A1 - B1) - D0;
+        const float DeltaSquared = Delta.SizeSquared();
+        OutAlpha = DeltaSquared > SmallNumber ? Clamp(-FVec3::Dot(D0, Delta) / DeltaSquared, 0.0f, 1.0f) : 0.0f;
+        return (D0 + Delta * OutAlpha).SizeSquared();
+    }
+
+    bool SweptProximity(const FProjectileState& State, const FVec3& MissilePosition, const FVec3& MissileVelocity,
+                        float Dt, float Radius)
+    {
+        float Alpha = 0.0f;
+        const float DistSquared = SweptClosestDistSquared(State.PreviousPosition, State.Position,
+                                                          MissilePosition - MissileVelocity * Dt, MissilePosition, Alpha);
+        return DistSquared < Radius * Radius;
+    }
+}
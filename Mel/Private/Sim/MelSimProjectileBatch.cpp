@@ -0,0 +1,84 @@
+#include "Sim/MelSimProjectileBatch.h"
+
+namespace MelSim
+{
+    namespace
+    {
+        template <typename T>
+        void MoveLast(std::vector<T>& Values, int32_t Index)
+        {
+            Values[Index] = Values.back();
+            Values.pop_back();
+        }
+    }
+
+    int32_t FProjectileBatch::Add(const FProjectileState& State)
+    {
+        const int32_t Index = Num();
+
+        int32_t Id;
+        if (!FreeIds.empty())
+        {
+            Id = FreeIds.back();
+            FreeIds.pop_back();
+            IdToIndex[Id] = Index;
+        }
+        else
+        {
+            Id = static_cast<int32_t>(IdToIndex.size());
+            IdToIndex.push_back(Index);
+        }
+        IndexToId.push_back(Id);
+
+        States.push_back(State);
+        TargetPositions.push_back(FVec3());
+        TargetVelocities.push_back(FVec3());
+        HasTarget.push_back(0);
+        Results.push_back(static_cast<uint8_t>(EProjectileResult::None));
+        return Id;
+    }
+
+    void FProjectileBatch::Remove(int32_t Id)
+    {
+        if (!Contains(Id))
+            return;
+
+        const int32_t Index = IdToIndex[Id];
+        const int32_t LastId = IndexToId.back();
+
+        MoveLast(States, Index);
+        MoveLast(TargetPositions, Index);
+        MoveLast(TargetVelocities, Index);
+        MoveLast(HasTarget, Index);
+        MoveLast(Results, Index);
+        MoveLast(IndexToId, Index);
+
+        IdToIndex[LastId] = Index;
+        IdToIndex[Id] = -1;
+        FreeIds.push_back(Id);
+    }
+
+    bool FProjectileBatch::Contains(int32_t Id) const
+    {
+        return Id >= 0 && Id < static_cast<int32_t>(IdToIndex.size()) && IdToIndex[Id] >= 0;
+    }
+
+    void FProjectileBatch::SetTarget(int32_t Index, const FVec3& Position, const FVec3& Velocity)
+    {
+        TargetPositions[Index] = Position;
+        TargetVelocities[Index] = Velocity;
+        HasTarget[Index] = 1;
+    }
+
+    void FProjectileBatch::StepRange(int32_t Begin, int32_t End, float Dt)
+    {
+        // Каждый снаряд читает только свою цель и пишет только свое состояние
+        for (int32_t Index = Begin; Index < End; ++Index)
+        {
+            const bool bHasTarget = HasTarget[Index] != 0;
+            const EProjectileResult Result = StepProjectile(States[Index],
+                bHasTarget ? &TargetPositions[Index] : nullptr, bHasTarget ? &TargetVelocities[Index] : nullptr, Dt);
+            Results[Index] = static_cast<uint8_t>(Result);
+        }
+    }
+}
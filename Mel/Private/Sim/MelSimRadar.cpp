@@ -0,0 +1,227 @@
+#include "Sim/MelSimRadar.h"
+#include <algorithm>
+
+namespace MelSim
+{
+    // Соседние под-сканы перекрываются на доли градуса: цель точно на стыке не теряется из-за округления
+    static constexpr float SweepSeamOverlap = 0.01f;
+
+    float AdvanceScanAngle(float ScanAngle, float ScanSpeed, float Dt)
+    {
+        ScanAngle += ScanSpeed * Dt;
+        if (ScanAngle >= 360.0f)
+        {
+            ScanAngle -= 360.0f;
+        }
+        return ScanAngle;
+    }
+
+    bool IsInHeightRange(const FRadarParams& Params, const FVec3& Location)
+    {
+        return Location.Z >= Params.MinDetectionHeight && Location.Z <= Params.MaxDetectionHeight;
+    }
+
+    bool IsInScanSector(const FRadarParams& Params, const FVec3& RadarLocation, float ScanAngle, const FVec3& Location)
+    {
+        FVec3 DirectionToMissile = Location - RadarLocation;
+        DirectionToMissile.Z = 0.0f;
+        if (DirectionToMissile.Size() > Params.ScanRadius)
+            return false;
+
+        DirectionToMissile = DirectionToMissile.GetSafeNormal();
+
+        float MissileAngle = RadiansToDegrees(std::atan2(DirectionToMissile.Y, DirectionToMissile.X));
+        if (MissileAngle < 0.0f)
+        {
+            MissileAngle += 360.0f;
+        }
+
+        float AngleDifference = std::fabs(MissileAngle - ScanAngle);
+        if (AngleDifference > 180.0f)
+        {
+            AngleDifference = 360.0f - AngleDifference;
+        }
+
+        return AngleDifference <= Params.ScanSectorWidth * 0.5f;
+    }
+
+    int32_t AdvanceSweep(const FRadarParams& Params, FSweepClock& Clock, float Dt, FSweepInterval* OutIntervals)
+    {
+        Clock.TimeSinceLastScan += Dt;
+        if (Params.ScanInterval <= 0.0f)
+            return 0;
+
+        const int32_t NumDue = static_cast<int32_t>(std::floor(Clock.TimeSinceLastScan / Params.ScanInterval));
+        if (NumDue <= 0)
+            return 0;
+
+        Clock.TimeSinceLastScan = std::max(Clock.TimeSinceLastScan - static_cast<float>(NumDue) * Params.ScanInterval, 0.0f);
+
+        // Шаги сверх лимита сливаются в первый под-скан: его сектор шире, но слепой дуги не остается
+        const int32_t NumMerged = std::max(NumDue - MaxSubScansPerStep, 0) + 1;
+        const float StepSweep = Params.ScanSpeed * Params.ScanInterval;
+
+        int32_t NumIntervals = 0;
+        for (int32_t Step = 0; Step < NumDue; )
+        {
+            const int32_t Steps = (NumIntervals == 0) ? NumMerged : 1;
+            const float From = Clock.SweepAngle;
+
+            // Угол продвигается по шагу, как при любой другой нарезке кадров
+            for (int32_t i = 0; i < Steps; ++i)
+            {
+                Clock.SweepAngle = AdvanceScanAngle(Clock.SweepAngle, Params.ScanSpeed, Params.ScanInterval);
+            }
+
+            Step += Steps;
+
+            // Передний край луча: [From + W/2, To + W/2]; самый первый под-скан добавляет луч в начале
+            const float Swept = StepSweep * static_cast<float>(Steps);
+            const float HalfBeam = Params.ScanSectorWidth * 0.5f;
+            FSweepInterval& Interval = OutIntervals[NumIntervals++];
+            if (Clock.bStarted)
+            {
+                Interval.CenterAngle = From + HalfBeam + Swept * 0.5f;
+                Interval.Width = std::min(Swept + SweepSeamOverlap, 360.0f);
+            }
+            else
+            {
+                Interval.CenterAngle = From + Swept * 0.5f;
+                Interval.Width = std::min(Params.ScanSectorWidth + Swept, 360.0f);
+                Clock.bStarted = true;
+            }
+            Interval.Age = Clock.TimeSinceLastScan + static_cast<float>(NumDue - Step) * Params.ScanInterval;
+        }
+        return NumIntervals;
+    }
+
+    float GetBeamAngle(const FRadarParams& Params, const FSweepClock& Clock)
+    {
+        return AdvanceScanAngle(Clock.SweepAngle, Params.ScanSpeed, Clock.TimeSinceLastScan);
+    }
+
+    FSweptSectorTest::FSweptSectorTest(const FRadarParams& Params, const FVec3& RadarLocation, const FSweepInterval& Interval)
+        : Origin(RadarLocation)
+    {
+        const float CenterRad = DegreesToRadians(Interval.CenterAngle);
+        AxisX = std::cos(CenterRad);
+        AxisY = std::sin(CenterRad);
+        CosHalfWidth = std::cos(DegreesToRadians(Interval.Width * 0.5f));
+        RadiusSquared = Params.ScanRadius * Params.ScanRadius;
+    }
+
+    bool FSweptSectorTest::Contains(const FVec3& Location) const
+    {
+        const float X = Location.X - Origin.X;
+        const float Y = Location.Y - Origin.Y;
+        const float DistanceSquared = X * X + Y * Y;
+        if (DistanceSquared > RadiusSquared)
+            return false;
+
+        // Цель прямо над радаром считается на азимуте 0, как в IsInScanSector
+        if (DistanceSquared <= KindaSmallNumber)
+            return AxisX >= CosHalfWidth;
+
+        // Угол до оси сектора не больше половины ширины - сравнение косинусов без Atan2
+        return X * AxisX + Y * AxisY >= CosHalfWidth * std::sqrt(DistanceSquared);
+    }
+
+    void PredictTrajectory(const FRadarParams& Params, const FVec3& Position, const FVec3& Velocity, FVec3& InOutPredicted)
+    {
+        if (Velocity.SizeSquared() < 1.0f)
+            return;
+
+        // Простое предсказание: ракета продолжит движение с текущей скоростью
+        InOutPredicted = Position + Velocity * Params.PredictionTime;
+
+        // Если ракета движется вниз, предсказываем точку падения
+        if (Velocity.Z < -100.0f)
+        {
+            const float TimeToGround = -Position.Z / Velocity.Z;
+            if (TimeToGround > 0.0f && TimeToGround < Params.PredictionTime)
+            {
+                InOutPredicted = Position + Velocity * TimeToGround;
+                InOutPredicted.Z = 0.0f;
+            }
+        }
+    }
+
+    float ComputeThreatLevel(const FRadarParams& Params, const FVec3& RadarLocation,
+                             const FVec3& Position, const FVec3& Velocity, float Distance)
+    {
+        // Фактор расстояния (ближе = опаснее)
+        const float DistanceFactor = Clamp(1.0f - (Distance / Params.ScanRadius), 0.0f, 1.0f);
+
+        // Фактор скорости (быстрее = опаснее)
+        const float SpeedFactor = Clamp(Velocity.Size() / 2000.0f, 0.0f, 1.0f);
+
+        // Фактор высоты (ниже = опаснее, так как ближе к цели)
+        const float HeightFactor = Clamp(1.0f - (Position.Z / Params.MaxDetectionHeight), 0.0f, 1.0f);
+
+        // Фактор направления (движение к радару = опаснее)
+        const FVec3 DirectionToRadar = (RadarLocation - Position).GetSafeNormal();
+        const float DirectionFactor = Clamp(FVec3::Dot(Velocity.GetSafeNormal(), DirectionToRadar), 0.0f, 1.0f);
+
+        const float ThreatLevel = DistanceFactor * Params.ThreatDistanceWeight +
+                                  SpeedFactor * Params.ThreatSpeedWeight +
+                                  HeightFactor * Params.ThreatHeightWeight +
+                                  DirectionFactor * 0.2f; // Дополнительный вес для направления
+
+        return Clamp(ThreatLevel, 0.0f, 1.0f);
+    }
+
+    bool IsFarFieldTrack(const FRadarParams& Params, float Distance, float ThreatLevel)
+    {
+        return Params.FullDetailRange > 0.0f && Distance > Params.FullDetailRange && ThreatLevel < Params.FullDetailThreat;
+    }
+
+    bool ShouldSkipFarFieldUpdate(const FRadarParams& Params, const FTrackEstimate& Estimate, float Distance, float ThreatLevel, float Now)
+    {
+        return Estimate.NumUpdates > 0 && Now - Estimate.Time < Params.FarTrackUpdateInterval &&
+               IsFarFieldTrack(Params, Distance, ThreatLevel);
+    }
+
+    bool CountDetection(const FRadarParams& Params, bool bFarField, int32_t& DetectionCount, bool& bReportedTrajectory)
+    {
+        if (bReportedTrajectory)
+            return false;
+
+        const int32_t MaxDetections = bFarField ? std::min(Params.ConfirmDetections, Params.MaxDetections) : Params.MaxDetections;
+        const bool bCounted = DetectionCount < MaxDetections;
+        if (bCounted)
+        {
+            ++DetectionCount;
+        }
+        bReportedTrajectory = DetectionCount >= Params.MaxDetections;
+        return bCounted;
+    }
+
+    bool ApplyDetection(const FRadarParams& Params, const FVec3& RadarLocation, FTrack& Track, const FVec3& Position, float Now)
+    {
+        // Дальность по самому обнаружению: трек, вошедший в ближнюю зону, повышается сразу
+        const float DetectionDistance = (Position - RadarLocation).Size();
+        if (ShouldSkipFarFieldUpdate(Params, Track.Estimate, DetectionDistance, Track.ThreatLevel, Now))
+        {
+            Track.LastDetectionTime = Now;
+            return false;
+        }
+        const bool bFarField = IsFarFieldTrack(Params, DetectionDistance, Track.ThreatLevel);
+
+        UpdateTrackEstimate(Params.Filter, Track.Estimate, Position, Now);
+        Track.Position = Track.Estimate.Position;
+        Track.Velocity = Track.Estimate.Velocity;
+        Track.Acceleration = Track.Estimate.Acceleration;
+        Track.Distance = (Track.Position - RadarLocation).Size();
+        Track.LastDetectionTime = Now;
+
+        // После полного отчета о траектории обнаружения больше не считаются, но оценка уточняется
+        const bool bCounted = CountDetection(Params, bFarField, Track.DetectionCount, Track.bReportedTrajectory);
+
+        if (!bFarField)
+        {
+            PredictTrajectory(Params, Track.Position, Track.Velocity, Track.PredictedPosition);
+        }
+        Track.ThreatLevel = ComputeThreatLevel(Params, RadarLocation, Track.Position, Track.Velocity, Track.Distance);
+        return bCounted;
+    }
+}
@@ -0,0 +1,152 @@
+#include "Sim/MelSimReplay.h"
+#include "Sim/MelSimEngagement.h"
+#include <cstring>
+
+namespace MelSim
+{
+    namespace
+    {
+        constexpr uint32_t ReplayMagic = 0x524C454D; // "MELR"
+        constexpr uint32_t ReplayVersion = 1;
+        constexpr size_t HeaderSize = 4 * sizeof(uint32_t);
+        constexpr size_t EventSize = sizeof(int32_t) + sizeof(uint8_t) + 6 * sizeof(float);
+
+        template <typename T>
+        void Write(std::vector<uint8_t>& Bytes, const T& Value)
+        {
+            const size_t Offset = Bytes.size();
+            Bytes.resize(Offset + sizeof(T));
+            std::memcpy(Bytes.data() + Offset, &Value, sizeof(T));
+        }
+
+        template <typename T>
+        T Read(const uint8_t*& Cursor)
+        {
+            T Value;
+            std::memcpy(&Value, Cursor, sizeof(T));
+            Cursor += sizeof(T);
+            return Value;
+        }
+
+        void WriteVec(std::vector<uint8_t>& Bytes, const FVec3& V)
+        {
+            Write(Bytes, V.X);
+            Write(Bytes, V.Y);
+            Write(Bytes, V.Z);
+        }
+
+        FVec3 ReadVec(const uint8_t*& Cursor)
+        {
+            const float X = Read<float>(Cursor);
+            const float Y = Read<float>(Cursor);
+            const float Z = Read<float>(Cursor);
+            return FVec3(X, Y, Z);
+        }
+
+        bool SameBits(const FVec3& A, const FVec3& B)
+        {
+            return std::memcmp(&A, &B, sizeof(FVec3)) == 0;
+        }
+    }
+
+    bool FReplayEvent::operator==(const FReplayEvent& Other) const
+    {
+        return Step == Other.Step && Type == Other.Type && SameBits(Position, Other.Position) && SameBits(Target, Other.Target);
+    }
+
+    void FReplayLog::Reset(uint32_t InSeed, float InStepTime)
+    {
+        Seed = InSeed;
+        StepTime = InStepTime;
+        Events.clear();
+    }
+
+    void FReplayLog::Save(std::vector<uint8_t>& OutBytes) const
+    {
+        OutBytes.clear();
+        OutBytes.reserve(HeaderSize + Events.size() * EventSize);
+
+        Write(OutBytes, ReplayMagic);
+        Write(OutBytes, ReplayVersion);
+        Write(OutBytes, Seed);
+        Write(OutBytes, StepTime);
+
+        for (const FReplayEvent& Event : Events)
+        {
+            Write(OutBytes, Event.Step);
+            Write(OutBytes, static_cast<uint8_t>(Event.Type));
+            WriteVec(OutBytes, Event.Position);
+            WriteVec(OutBytes, Event.Target);
+        }
+    }
+
+    bool FReplayLog::Load(const uint8_t* Bytes, size_t Size)
+    {
+        if (!Bytes || Size < HeaderSize || (Size - HeaderSize) % EventSize != 0)
+            return false;
+
+        const uint8_t* Cursor = Bytes;
+        if (Read<uint32_t>(Cursor) != ReplayMagic || Read<uint32_t>(Cursor) != ReplayVersion)
+            return false;
+
+        Seed = Read<uint32_t>(Cursor);
+        StepTime = Read<float>(Cursor);
+
+        const size_t NumEvents = (Size - HeaderSize) / EventSize;
+        Events.clear();
+        Events.reserve(NumEvents);
+        for (size_t i = 0; i < NumEvents; ++i)
+        {
+            FReplayEvent Event;
+            Event.Step = Read<int32_t>(Cursor);
+            Event.Type = static_cast<EReplayEventType>(Read<uint8_t>(Cursor));
+            Event.Position = ReadVec(Cursor);
+            Event.Target = ReadVec(Cursor);
+            Events.push_back(Event);
+        }
+        return true;
+    }
+
+    int32_t FReplayLog::FindDivergence(const FReplayLog& Other) const
+    {
+        if (Seed != Other.Seed || StepTime != Other.StepTime)
+            return 0;
+
+        const size_t NumCommon = Events.size() < Other.Events.size() ? Events.size() : Other.Events.size();
+        for (size_t i = 0; i < NumCommon; ++i)
+        {
+            if (Events[i] != Other.Events[i])
+                return static_cast<int32_t>(i);
+        }
+        return Events.size() == Other.Events.size() ? -1 : static_cast<int32_t>(NumCommon);
+    }
+
+    FEngagementStats ReplayEngagement(const FReplayLog& Log, FEngagement& Engagement, float MaxTime)
+    {
+        const std::vector<FReplayEvent>& Events = Log.GetEvents();
+        size_t Next = 0;
+
+        for (int32_t Step = 0; ; ++Step)
+        {
+            // Размещение и пуски этого шага; выстрелы симуляция решает сама
+            for (; Next < Events.size() && Events[Next].Step <= Step; ++Next)
+            {
+                const FReplayEvent& Event = Events[Next];
+                switch (Event.Type)
+                {
+                case EReplayEventType::Radar:   Engagement.AddRadar(Event.Position); break;
+                case EReplayEventType::Battery: Engagement.AddBattery(Event.Position, 0); break;
+                case EReplayEventType::Missile: Engagement.AddMissile(Event.Position, Event.Target); break;
+                case EReplayEventType::Fire:    break;
+                }
+            }
+
+            // Бой закончен, когда события исчерпаны и ракет не осталось
+            if ((Next == Events.size() && !Engagement.HasLiveMissiles()) || Engagement.GetTime() >= MaxTime)
+                break;
+
+            Engagement.Step(Log.StepTime);
+        }
+        return Engagement.GetStats();
+    }
+}
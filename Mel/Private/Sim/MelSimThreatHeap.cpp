@@ -0,0 +1,142 @@
+#include "Sim/MelSimThreatHeap.h"
+#include <algorithm>
+#include <utility>
+
+namespace MelSim
+{
+    bool FThreatHeap::Contains(int32_t Key) const
+    {
+        return Key >= 0 && Key < static_cast<int32_t>(Positions.size()) && Positions[Key] >= 0;
+    }
+
+    void FThreatHeap::Reset()
+    {
+        Keys.clear();
+        Threats.clear();
+        Positions.clear();
+    }
+
+    void FThreatHeap::Set(int32_t Key, float Threat)
+    {
+        if (Key >= static_cast<int32_t>(Positions.size()))
+        {
+            Positions.resize(Key + 1, -1);
+        }
+
+        int32_t Position = Positions[Key];
+        if (Position < 0)
+        {
+            Position = Num();
+            Keys.push_back(Key);
+            Threats.push_back(Threat);
+            Positions[Key] = Position;
+            SiftUp(Position);
+            return;
+        }
+
+        const float OldThreat = Threats[Position];
+        Threats[Position] = Threat;
+        if (Threat > OldThreat)
+        {
+            SiftUp(Position);
+        }
+        else if (Threat < OldThreat)
+        {
+            SiftDown(Position);
+        }
+    }
+
+    void FThreatHeap::Remove(int32_t Key)
+    {
+        if (!Contains(Key))
+            return;
+
+        const int32_t Position = Positions[Key];
+        const int32_t Last = Num() - 1;
+        if (Position != Last)
+        {
+            SwapNodes(Position, Last);
+        }
+
+        Keys.pop_back();
+        Threats.pop_back();
+        Positions[Key] = -1;
+
+        // Перенесенный с конца узел может оказаться как выше, так и ниже соседей
+        if (Position < Num())
+        {
+            SiftUp(Position);
+            SiftDown(Positions[Keys[Position]]);
+        }
+    }
+
+    void FThreatHeap::GetTop(int32_t Count, std::vector<int32_t>& OutKeys) const
+    {
+        OutKeys.clear();
+        if (Count <= 0)
+            return;
+
+        VisitDescending([&OutKeys, Count](int32_t Key)
+        {
+            OutKeys.push_back(Key);
+            return static_cast<int32_t>(OutKeys.size()) >= Count;
+        });
+    }
+
+    void FThreatHeap::SwapNodes(int32_t A, int32_t B)
+    {
+        std::swap(Keys[A], Keys[B]);
+        std::swap(Threats[A], Threats[B]);
+        Positions[Keys[A]] = A;
+        Positions[Keys[B]] = B;
+    }
+
+    void FThreatHeap::SiftUp(int32_t Position)
+    {
+        while (Position > 0)
+        {
+            const int32_t Parent = (Position - 1) / 2;
+            if (!IsAbove(Position, Parent))
+                break;
+
+            SwapNodes(Position, Parent);
+            Position = Parent;
+        }
+    }
+
+    void FThreatHeap::SiftDown(int32_t Position)
+    {
+        const int32_t Count = Num();
+        for (;;)
+        {
+            const int32_t Left = Position * 2 + 1;
+            if (Left >= Count)
+                break;
+
+            int32_t Best = Left;
+            if (Left + 1 < Count && IsAbove(Left + 1, Left))
+            {
+                Best = Left + 1;
+            }
+            if (!IsAbove(Best, Position))
+                break;
+
+            SwapNodes(Position, Best);
+            Position = Best;
+        }
+    }
+
+    void FThreatHeap::PushFrontier(std::vector<int32_t>& Frontier, int32_t Position) const
+    {
+        Frontier.push_back(Position);
+        std::push_heap(Frontier.begin(), Frontier.end(), [this](int32_t A, int32_t B) { return IsAbove(B, A); });
+    }
+
+    int32_t FThreatHeap::PopFrontier(std::vector<int32_t>& Frontier) const
+    {
+        std::pop_heap(Frontier.begin(), Frontier.end(), [this](int32_t A, int32_t B) { return IsAbove(B, A); });
+        const int32_t Position = Frontier.back();
+        Frontier.pop_back();
+        return Position;
+    }
+}
@@ -0,0 +1,93 @@
+#include "Sim/MelSimTrackFilter.h"
+#include <algorithm>
+
+namespace MelSim
+{
+    FTrackFilterParams MakeTrackFilterParams(float Discount)
+    {
+        const float Theta = Clamp(Discount, 0.0f, 0.99f);
+        const float OneMinusTheta = 1.0f - Theta;
+
+        FTrackFilterParams Params;
+        Params.Alpha = 1.0f - Theta * Theta * Theta;
+        Params.Beta = 1.5f * OneMinusTheta * OneMinusTheta * (1.0f + Theta);
+        Params.Gamma = 0.5f * OneMinusTheta * OneMinusTheta * OneMinusTheta;
+        return Params;
+    }
+
+    void UpdateTrackEstimate(const FTrackFilterParams& Params, FTrackEstimate& Estimate, const FVec3& Position, float Time)
+    {
+        const float Dt = Time - Estimate.Time;
+        if (Estimate.NumUpdates == 0)
+        {
+            Estimate.Position = Position;
+            Estimate.Velocity = FVec3();
+            Estimate.Acceleration = FVec3();
+        }
+        else if (Dt < Params.MinInterval)
+        {
+            // Повторное обнаружение в тот же момент: только уточнение положения
+            Estimate.Position += (Position - Estimate.Position) * Params.Alpha;
+            return;
+        }
+        else if (Estimate.NumUpdates == 1)
+        {
+            // Скорость по двум точкам, ускорение пока неизвестно
+            Estimate.Velocity = (Position - Estimate.Position) * (1.0f / Dt);
+            Estimate.Position = Position;
+        }
+        else
+        {
+            // Прогноз на момент обнаружения и поправка по невязке
+            const FVec3 PredictedPosition = ExtrapolateTrack(Estimate, Dt);
+            const FVec3 PredictedVelocity = Estimate.Velocity + Estimate.Acceleration * Dt;
+            const FVec3 Residual = Position - PredictedPosition;
+
+            Estimate.Position = PredictedPosition + Residual * Params.Alpha;
+            Estimate.Velocity = PredictedVelocity + Residual * (Params.Beta / Dt);
+            Estimate.Acceleration += Residual * (2.0f * Params.Gamma / (Dt * Dt));
+        }
+
+        Estimate.Time = Time;
+        ++Estimate.NumUpdates;
+    }
+
+    void UpdateTrackEstimates(const FTrackFilterParams& Params, FTrackEstimate* Estimates,
+                              const FTrackMeasurement* Measurements, int32_t NumMeasurements)
+    {
+        for (int32_t i = 0; i < NumMeasurements; ++i)
+        {
+            const FTrackMeasurement& Measurement = Measurements[i];
+            UpdateTrackEstimate(Params, Estimates[Measurement.Index], Measurement.Position, Measurement.Time);
+        }
+    }
+
+    FVec3 ExtrapolateTrack(const FTrackEstimate& Estimate, float Dt)
+    {
+        return Estimate.Position + Estimate.Velocity * Dt + Estimate.Acceleration * (0.5f * Dt * Dt);
+    }
+
+    void FTrackFusion::Add(const FTrackEstimate& Estimate, float Time)
+    {
+        const float Age = std::max(Time - Estimate.Time, 0.0f);
+        const float Weight = 1.0f / (1.0f + Age);
+        PositionSum += ExtrapolateTrack(Estimate, Age) * Weight;
+        WeightSum += Weight;
+
+        if (Estimate.NumUpdates >= 2)
+        {
+            VelocitySum += (Estimate.Velocity + Estimate.Acceleration * Age) * Weight;
+            VelocityWeightSum += Weight;
+        }
+    }
+
+    FVec3 FTrackFusion::GetPosition() const
+    {
+        return WeightSum > 0.0f ? PositionSum * (1.0f / WeightSum) : FVec3();
+    }
+
+    FVec3 FTrackFusion::GetVelocity() const
+    {
+        return VelocityWeightSum > 0.0f ? VelocitySum * (1.0f / VelocityWeightSum) : FVec3();
+    }
+}
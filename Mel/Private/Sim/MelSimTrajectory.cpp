@@ -0,0 +1,125 @@
+#include "Sim/MelSimTrajectory.h"
+#include <algorithm>
+
+namespace MelSim
+{
+    namespace
+    {
+        // Интеграл SmoothStep01 от 0 до X
+        float SmoothStepIntegral(float X)
+        {
+            X = Clamp(X, 0.0f, 1.0f);
+            return X * X * X - 0.5f * X * X * X * X;
+        }
+
+        FVec3 EvaluateSegment(const FTrajectorySegment& Segment, float T)
+        {
+            FVec3 Position = Segment.Start + Segment.Velocity * T;
+            if (Segment.TurnRate > 0.0f)
+            {
+                Position += Segment.Turn * (SmoothStepIntegral(Segment.TurnStart + T * Segment.TurnRate) - SmoothStepIntegral(Segment.TurnStart));
+            }
+            return Position;
+        }
+
+        // Прямой участок с постоянной скоростью; возвращает время окончания
+        float AddLine(FMissileTrajectory& Trajectory, EMissilePhase Phase, const FVec3& Start, const FVec3& End, float Speed, float Time)
+        {
+            const FVec3 Offset = End - Start;
+            const float Duration = Speed > 0.0f ? Offset.Size() / Speed : 0.0f;
+
+            FTrajectorySegment& Segment = Trajectory.Segments[Trajectory.NumSegments++];
+            Segment.Phase = Phase;
+            Segment.Start = Start;
+            Segment.Velocity = Duration > 0.0f ? Offset * (1.0f / Duration) : FVec3();
+            Segment.StartTime = Time;
+            Segment.Duration = Duration;
+            return Time + Duration;
+        }
+
+        // Участок перехода: направление скорости Lerp(вверх, Direction, SmoothStep(Elapsed / TransitionTime))
+        float AddTurn(FMissileTrajectory& Trajectory, const FVec3& Start, const FVec3& Direction, float Elapsed,
+                      const FMissileParams& Params, float Time, FVec3& OutEnd)
+        {
+            const FVec3 Up(0.0f, 0.0f, 1.0f);
+
+            FTrajectorySegment& Segment = Trajectory.Segments[Trajectory.NumSegments++];
+            Segment.Phase = EMissilePhase::Transition;
+            Segment.Start = Start;
+            Segment.StartTime = Time;
+            Segment.Duration = std::max(Params.TransitionTime - Elapsed, 0.0f);
+            if (Params.TransitionTime > 0.0f)
+            {
+                Segment.Velocity = Up * Params.Speed;
+                Segment.Turn = (Direction - Up) * (Params.Speed * Params.TransitionTime);
+                Segment.TurnStart = Elapsed / Params.TransitionTime;
+                Segment.TurnRate = 1.0f / Params.TransitionTime;
+            }
+
+            OutEnd = EvaluateSegment(Segment, Segment.Duration);
+            return Time + Segment.Duration;
+        }
+
+        FVec3 MakeHorizontalEnd(const FVec3& HorizontalStart, const FVec3& TargetPoint, const FMissileParams& Params)
+        {
+            FVec3 HorizontalEnd = HorizontalStart + (TargetPoint - HorizontalStart).GetSafeNormal() * Params.HorizontalDistance;
+            HorizontalEnd.Z = Params.HorizontalHeight;
+            return HorizontalEnd;
+        }
+    }
+
+    FMissileTrajectory BuildMissileTrajectory(const FMissileState& State, const FMissileParams& Params, float Now)
+    {
+        FMissileTrajectory Trajectory;
+        Trajectory.Phase = State.Phase;
+        Trajectory.ImpactPoint = State.TargetPoint;
+
+        // Участки строятся с текущей фазы до снижения; каждая ветка продолжается в следующую
+        float Time = Now;
+        FVec3 Position = State.Position;
+        FVec3 HorizontalEnd = State.HorizontalEndPoint;
+        switch (State.Phase)
+        {
+            case EMissilePhase::Ascending:
+            {
+                FVec3 AscentEnd = Position;
+                AscentEnd.Z = std::max(Position.Z, Params.TargetHeight);
+                Time = AddLine(Trajectory, EMissilePhase::Ascending, Position, AscentEnd, Params.Speed, Time);
+                Time = AddTurn(Trajectory, AscentEnd, (State.TargetPoint - AscentEnd).GetSafeNormal(), 0.0f, Params, Time, Position);
+                HorizontalEnd = MakeHorizontalEnd(Position, State.TargetPoint, Params);
+                Time = AddLine(Trajectory, EMissilePhase::Horizontal, Position, HorizontalEnd, Params.Speed, Time);
+                break;
+            }
+
+            case EMissilePhase::Transition:
+                Time = AddTurn(Trajectory, Position, State.TargetDirection, State.TransitionElapsed, Params, Time, Position);
+                HorizontalEnd = MakeHorizontalEnd(Position, State.TargetPoint, Params);
+                Time = AddLine(Trajectory, EMissilePhase::Horizontal, Position, HorizontalEnd, Params.Speed, Time);
+                break;
+
+            case EMissilePhase::Horizontal:
+                Time = AddLine(Trajectory, EMissilePhase::Horizontal, Position, HorizontalEnd, Params.Speed, Time);
+                break;
+
+            case EMissilePhase::Descent:
+                HorizontalEnd = Position;
+                break;
+        }
+
+        Trajectory.ImpactTime = AddLine(Trajectory, EMissilePhase::Descent, HorizontalEnd, State.TargetPoint, Params.Speed, Time);
+        return Trajectory;
+    }
+
+    FVec3 EvaluateTrajectory(const FMissileTrajectory& Trajectory, float Time)
+    {
+        for (int32_t Index = 0; Index < Trajectory.NumSegments; ++Index)
+        {
+            const FTrajectorySegment& Segment = Trajectory.Segments[Index];
+            if (Time < Segment.StartTime + Segment.Duration)
+            {
+                return EvaluateSegment(Segment, std::max(Time - Segment.StartTime, 0.0f));
+            }
+        }
+        return Trajectory.ImpactPoint;
+    }
+}
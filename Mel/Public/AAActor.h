@@ -2,12 +2,20 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Sim/MelSimIntercept.h"
 #include "AAActor.generated.h"
 
-class ARadarActor;
 class AMissleActor;
 class AAAProjectileActor;
+class UMissileMovementSubsystem;
+class UMelActorPoolSubsystem;
+class UEngagementClockSubsystem;
+class UFireControlSubsystem;
+class URadarNetworkSubsystem;
+struct FRadarFusedTrack;
 
+// Батарея ПВО. Цели назначает UFireControlSubsystem по слитой картине всех радаров сети;
+// батарея перезаряжается и стреляет по назначению.
 UCLASS()
 class MEL_API AAAActor : public AActor
 {
@@ -15,11 +23,29 @@ class MEL_API AAAActor : public AActor
 
 public:
     AAAActor();
-    virtual void Tick(float DeltaTime) override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-    // Установить ссылку на радар
-    void SetRadar(ARadarActor* Radar);
+    // Класс снаряда для батарей, созданных без Blueprint (до BeginPlay - пул заполняется в нем)
+    void SetProjectileClass(TSubclassOf<AAAProjectileActor> InProjectileClass);
+    bool HasProjectileClass() const { return ProjectileClass != nullptr; }
+
+    // Время боя, к которому батарея перезарядится
+    float GetReadyTime() const { return ReadyTime; }
+
+    // Батарея перезаряжена, в сети есть радары и задан класс снаряда
+    bool IsReadyToFire() const;
+    bool IsInRange(const FVector& Location) const;
+
+    // Точка встречи снаряда с целью от оценки слитого трека: по профилю фаз ракеты,
+    // без него - как с равномерной целью
+    bool SolveFireControl(const FRadarFusedTrack& Target, MelSim::FInterceptSolution& OutIntercept) const;
+
+    // Вероятность поражения одним снарядом при встрече через InterceptTime
+    float EstimateKillProbability(float InterceptTime) const;
+
+    // Выстрел по назначенной цели в точку встречи
+    void FireAt(AMissleActor* Target, const MelSim::FInterceptSolution& Intercept, float KillProbability);
 
 protected:
     UPROPERTY(EditAnywhere, Category = "AA Settings")
@@ -37,13 +63,23 @@ protected:
     UPROPERTY(EditAnywhere, Category = "AA Settings")
     float DetectionRadius = 20000.0f;
 
+    UPROPERTY(EditAnywhere, Category = "AA Settings")
+    float MaxInterceptTime = 30.0f; // Дальше по времени точка встречи не ищется (время жизни снаряда)
+
+    UPROPERTY(EditAnywhere, Category = "AA Settings")
+    int32 ProjectilePoolSize = 16; // Снарядов в пуле заранее (MaxFlightTime / FireInterval с запасом)
+
+    UPROPERTY(EditAnywhere, Category = "AA Settings")
+    float KillProbability = 0.8f; // Вероятность поражения при встрече сразу после пуска, падает к MaxInterceptTime
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UStaticMeshComponent* Mesh;
 
 private:
-    ARadarActor* RadarRef;
-    float TimeSinceLastFire;
-
-    void TryFireAtMissile();
-    AMissleActor* FindTargetMissile();
+    URadarNetworkSubsystem* RadarNetwork;
+    UMissileMovementSubsystem* MovementSystem;
+    UMelActorPoolSubsystem* ActorPool;
+    UEngagementClockSubsystem* EngagementClock;
+    UFireControlSubsystem* FireControl;
+    float ReadyTime;
 }; 
\ No newline at end of file
@@ -2,22 +2,36 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Sim/MelSimProjectile.h"
+#include "MelPoolable.h"
 #include "AAProjectileActor.generated.h"
 
 class AMissleActor;
+class UProjectileGuidanceSubsystem;
 
+// Снаряд ПВО - отображение записи пакета UProjectileGuidanceSubsystem: полет, наведение
+// и попадания считает подсистема, актор не тикает и только получает трансформ.
 UCLASS()
-class MEL_API AAAProjectileActor : public AActor
+class MEL_API AAAProjectileActor : public AActor, public IMelPoolable
 {
     GENERATED_BODY()
 
 public:
     AAAProjectileActor();
-    virtual void Tick(float DeltaTime) override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-    // Инициализация снаряда
-    void InitProjectile(AMissleActor* Target, float ForwardDistance, float Speed);
+    // Инициализация снаряда; KillProbability - оценка батареи при пуске для распределения целей
+    void InitProjectile(AMissleActor* Target, float ForwardDistance, float Speed, float KillProbability = 0.0f);
+
+    // Запись результата шага пакета наведения
+    void ApplyBatchedGuidance(const FVector& NewLocation, const FVector& NewForward);
+
+    float GetMaxFlightTime() const { return MaxFlightTime; }
+
+    // IMelPoolable
+    virtual void OnAcquiredFromPool() override;
+    virtual void OnReleasedToPool() override;
 
 protected:
     UPROPERTY(EditAnywhere, Category = "Projectile")
@@ -29,14 +43,22 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Projectile")
     float HomingAcceleration = 8000.0f;
 
+    UPROPERTY(EditAnywhere, Category = "Projectile")
+    float MaxFlightTime = 30.0f; // Промахнувшийся снаряд возвращается в пул
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UStaticMeshComponent* Mesh;
 
 private:
-    AMissleActor* TargetMissile;
-    FVector StartLocation;
-    float TravelledDistance;
-    bool bIsHoming;
-    
-    void CheckCollisionWithMissiles();
+    UProjectileGuidanceSubsystem* GuidanceSystem;
+
+    // Идентификатор в пакете наведения или INDEX_NONE, если снаряд не летит
+    int32 GuidanceId;
+    float KillProbability;
+
+    // Снаряд лежит в пуле - не зарегистрирован в пакете наведения
+    bool bPooledIdle;
+
+    void StartFlight(AMissleActor* Target);
+    void StopFlight();
 }; 
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Math/RandomStream.h"
+#include "Sim/MelSimClock.h"
+#include "Sim/MelSimReplay.h"
+#include "Sim/MelSimEngagement.h"
+#include "EngagementClockSubsystem.generated.h"
+
+class UMissileMovementSubsystem;
+class URadarNetworkSubsystem;
+class UFireControlSubsystem;
+class UProjectileGuidanceSubsystem;
+class UMissileWaveSubsystem;
+class UEngagementClockSubsystem;
+
+// Время шагов боя по подсистемам (секунды реального времени с начала мира)
+struct FMelEngagementTimings
+{
+    double MissileSeconds = 0.0;
+    double RadarSeconds = 0.0;
+    double FireControlSeconds = 0.0;
+    double ProjectileSeconds = 0.0;
+};
+
+// Функция тика часов боя в группе TG_PrePhysics: шаг боя выполняется до тика акторов кадра
+USTRUCT()
+struct FMelEngagementTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UEngagementClockSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FMelEngagementTickFunction> : public TStructOpsTypeTraitsBase2<FMelEngagementTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+// Часы боя с фиксированным шагом (mel.Engagement.FixedStep). Время кадра копится и расходуется
+// шагами длины 1 / mel.Engagement.StepRate; шаг запускает наступившие пуски волн и проводит ракеты,
+// радары, батареи ПВО и снаряды в этом порядке, как MelSim::FEngagement::Step. Без фиксированных часов выполняется один шаг
+// длиной в кадр в том же порядке. Часы тикают в TG_PrePhysics раньше акторов, поэтому актор,
+// читающий треки или ракеты (AddStepPrerequisite), видит состояние текущего кадра.
+// Зерно генератора, размещение, пуски и выстрелы пишутся в журнал по номерам шагов:
+// -MelRecord=<файл> сохраняет журнал при завершении мира, -MelReplay=<файл> берет из журнала
+// зерно и длину шага и сверяет с ним новые события. Журнал повторяется и без движка (MelSim::ReplayEngagement).
+UCLASS()
+class MEL_API UEngagementClockSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    // Шаги боя за кадр (из функции тика часов)
+    void Tick(float DeltaTime);
+
+    // Тик актора выполняется после шага боя этого кадра
+    void AddStepPrerequisite(AActor* Actor);
+
+    static bool IsFixedStepEnabled();
+
+    // Время боя: по фиксированным часам или, без них, время мира
+    static float GetEngagementTime(const UWorld* World);
+
+    // Генератор для случайных решений игры (точки пуска); зерно записано в журнале.
+    // В мире без часов боя - общий генератор с произвольным зерном.
+    static FRandomStream& GetRandomStream(const UWorld* World);
+
+    void RecordRadar(const FVector& Location);
+    void RecordBattery(const FVector& Location);
+    void RecordMissile(const FVector& LaunchPoint, const FVector& TargetPoint);
+    void RecordFire(const FVector& BatteryLocation, const FVector& TargetLocation);
+
+    // Исход полета ракеты: сбита снарядом или долетела до цели (в журнал не пишутся, только счетчики)
+    void RecordIntercept();
+    void RecordImpact();
+
+    // Счетчики боя как у MelSim::FEngagement и время шагов по подсистемам
+    const MelSim::FEngagementStats& GetStats() const { return Stats; }
+    const FMelEngagementTimings& GetTimings() const { return Timings; }
+
+    const MelSim::FReplayLog& GetLog() const { return Log; }
+    bool SaveLog(const FString& FileName) const;
+
+    int64 GetStepIndex() const { return Clock.StepIndex; }
+
+private:
+    UMissileMovementSubsystem* MovementSystem;
+    URadarNetworkSubsystem* RadarNetwork;
+    UFireControlSubsystem* FireControl;
+    UProjectileGuidanceSubsystem* ProjectileGuidance;
+    UMissileWaveSubsystem* WaveScheduler;
+
+    FMelEngagementTickFunction TickFunction;
+    MelSim::FFixedStepClock Clock;
+    FRandomStream RandomStream;
+
+    MelSim::FReplayLog Log;
+    MelSim::FReplayLog ReferenceLog;
+    bool bReplaying;
+    bool bDiverged;
+    FString RecordFileName;
+
+    MelSim::FEngagementStats Stats;
+    FMelEngagementTimings Timings;
+
+    void Step(float Dt);
+    void Record(MelSim::EReplayEventType Type, const FVector& Position, const FVector& Target);
+};
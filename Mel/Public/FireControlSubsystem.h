@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Sim/MelSimFireControl.h"
+#include "Sim/MelSimIntercept.h"
+#include "RadarNetworkSubsystem.h"
+#include "FireControlSubsystem.generated.h"
+
+class AAAActor;
+class AMissleActor;
+class URadarNetworkSubsystem;
+class UProjectileGuidanceSubsystem;
+
+// Централизованное управление огнем ПВО. Батареи не тикают: перезарядка - это время готовности.
+// Не чаще раза в 1 / mel.FireControl.Rate подсистема берет слитую картину сети радаров
+// и готовые батареи и распределяет цели жадным аукционом MelSim::FWeaponTargetAssignment
+// по ожидаемому приросту поражения (угроза x выживаемость цели x вероятность поражения по времени до встречи).
+// Снаряды, уже летящие в цель, снижают ее выживаемость, поэтому батареи не стреляют по одной ракете,
+// пропуская другие. Распределение спит, пока все батареи перезаряжаются или целей нет; будят его
+// окончание перезарядки ближайшей батареи и новые обнаружения радаров (GetDetectionRevision).
+// Шаги выполняет UEngagementClockSubsystem после шага радаров.
+UCLASS()
+class MEL_API UFireControlSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    void RegisterBattery(AAAActor* Battery);
+    void UnregisterBattery(AAAActor* Battery);
+
+    // Распределение целей, если есть готовая батарея и цели, но не чаще периода
+    void StepFireControl(float DeltaTime);
+
+private:
+    URadarNetworkSubsystem* RadarNetwork;
+    UProjectileGuidanceSubsystem* ProjectileGuidance;
+
+    // Порядок регистрации - порядок батарей в распределении
+    TArray<AAAActor*> Batteries;
+
+    float TimeSinceAssignment;
+
+    // Условия пробуждения: время готовности ближайшей батареи и цели на последнем распределении
+    float NextReadyTime;
+    bool bHasTargets;
+    uint32 SeenDetectionRevision;
+
+    // Рабочие буферы распределения (переиспользуются между проходами)
+    MelSim::FWeaponTargetAssignment Assignment;
+    TArray<FRadarFusedTrack> Targets;
+    TArray<float> TargetSurvivals;
+    TMap<AMissleActor*, int32> TargetIndexByMissile;
+    TArray<AAAActor*> ShooterBatteries;
+    TArray<MelSim::FInterceptSolution> OptionIntercepts;
+
+    void AssignTargets(float Now);
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MelActorPoolSubsystem.generated.h"
+
+// Пул акторов ракет и снарядов. Вместо SpawnActor/Destroy на каждый выстрел акторы создаются
+// заранее (Prewarm), выдаются через Acquire и возвращаются через Release скрытыми, без коллизии и тика.
+// Состояние сбрасывают сами акторы в IMelPoolable. Если свободных нет, Acquire создает новый актор.
+UCLASS()
+class MEL_API UMelActorPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // Создать Count свободных акторов класса
+    void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+    // Выдать актор из пула (или создать новый) в заданном трансформе
+    AActor* Acquire(TSubclassOf<AActor> ActorClass, const FTransform& Transform, AActor* Owner = nullptr);
+
+    template <typename ActorType>
+    ActorType* Acquire(TSubclassOf<ActorType> ActorClass, const FTransform& Transform, AActor* Owner = nullptr)
+    {
+        return Cast<ActorType>(Acquire(TSubclassOf<AActor>(ActorClass.Get()), Transform, Owner));
+    }
+
+    // Вернуть актор в пул. Акторы, созданные не пулом, уничтожаются.
+    void Release(AActor* Actor);
+
+    // Release через пул мира актора, Destroy - если пула нет
+    static void ReleaseOrDestroy(AActor* Actor);
+
+    int32 GetNumFree(TSubclassOf<AActor> ActorClass) const;
+
+private:
+    // Акторами владеет мир, пул держит слабые ссылки: актор, уничтоженный извне (например, при выгрузке
+    // уровня), перестает по ним находиться, а новый объект на том же адресе не считается пуловым.
+
+    // Свободные акторы по классу (LIFO - последний возвращенный еще "теплый" в кэше)
+    TMap<UClass*, TArray<TWeakObjectPtr<AActor>>> FreeActorsByClass;
+
+    // Все акторы пула и те из них, что сейчас свободны
+    TSet<TWeakObjectPtr<AActor>> PooledActors;
+    TSet<TWeakObjectPtr<AActor>> FreeActors;
+
+    AActor* SpawnPooled(UClass* ActorClass);
+    static void Deactivate(AActor* Actor);
+};
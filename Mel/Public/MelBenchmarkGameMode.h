@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "EngagementClockSubsystem.h"
+#include "MelBenchmarkGameMode.generated.h"
+
+class AMissleActor;
+class ARadarActor;
+class AAAActor;
+class AAAProjectileActor;
+class UMissileMovementSubsystem;
+class UProjectileGuidanceSubsystem;
+
+// Нагрузочный прогон: волны ракет против N радаров и M батарей ПВО на любой пустой карте.
+// Запуск без отрисовки:
+//   UnrealEditor-Cmd Mel.uproject <карта>?game=/Script/Mel.MelBenchmarkGameMode -game -nullrhi -unattended
+//       -benchmark -fps=60 -MelSeed=1 -MelBenchWaves=100,1000,10000 -MelBenchRadars=4 -MelBenchBatteries=8
+// -benchmark -fps=60 фиксирует шаг кадра, поэтому бой повторяется, а меряется только реальное время.
+// Волна идет, пока летят ракеты, но не дольше WaveTimeout секунд боя. По каждой волне пишется строка CSV
+// (-MelBenchCsv=<файл>, относительно Saved): время кадра, время шагов ракет, радаров, управления огнем
+// и снарядов за кадр, пик памяти и снарядов, запуски, поражения, прорывы и ракеты, не закончившие полет.
+// После последней волны игра завершается. Шаги боя идут по фиксированным часам - их время меряют часы.
+// Пол карте не нужен: ракета заканчивает полет в точке цели (FMissileBatch::HasReachedTarget).
+// Итоги волн и ошибки пишутся в лог (LogMel), экранных сообщений без отрисовки не видно.
+UCLASS(Config = Game)
+class MEL_API AMelBenchmarkGameMode : public AGameModeBase
+{
+    GENERATED_BODY()
+
+public:
+    AMelBenchmarkGameMode();
+
+    virtual void BeginPlay() override;
+    virtual void Tick(float DeltaSeconds) override;
+
+protected:
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    TSubclassOf<AMissleActor> MissileClass;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    TSubclassOf<ARadarActor> RadarClass;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    TSubclassOf<AAAActor> BatteryClass;
+
+    // Снаряд для батарей, у класса которых он не задан
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    TSubclassOf<AAAProjectileActor> ProjectileClass;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    TArray<int32> WaveSizes;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    int32 NumRadars = 4;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    int32 NumBatteries = 8;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    float LaunchHalfSize = 30000.0f; // Ракеты стартуют с краев квадрата вокруг цели в начале координат
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    float RadarRingRadius = 10000.0f;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    float BatteryRingRadius = 6000.0f;
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    float WaveTimeout = 120.0f; // Секунды боя
+
+    UPROPERTY(EditDefaultsOnly, Config, Category = "Benchmark")
+    FString CsvFileName = TEXT("Benchmarks/MelBenchmark.csv");
+
+private:
+    // Замер волны: счетчики и время шагов часов боя на начало волны, накопленное время кадров
+    struct FWaveSample
+    {
+        int32 NumMissiles = 0;
+        float StartTime = 0.0f;
+        MelSim::FEngagementStats StartStats;
+        FMelEngagementTimings StartTimings;
+        int32 NumFrames = 0;
+        double FrameSeconds = 0.0;
+        double MaxFrameSeconds = 0.0;
+        uint64 PeakMemory = 0;
+        int32 PeakProjectiles = 0;
+    };
+
+    UEngagementClockSubsystem* EngagementClock;
+    UMissileMovementSubsystem* MovementSystem;
+    UProjectileGuidanceSubsystem* ProjectileGuidance;
+
+    int32 WaveIndex;
+    FWaveSample Wave;
+    double LastFrameTime;
+    TArray<FString> CsvRows;
+
+    void ParseCommandLine();
+    void SpawnDefenses();
+    void StartWave();
+    void FinishWave();
+    void SampleMemory();
+    void SaveCsv() const;
+    FVector GetRandomEdgePosition(float Distance) const;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Отладочный вывод на экран. В Shipping и Test сборках макросы не генерируют кода
+// и не вычисляют аргументы.
+#define MEL_DEBUG_ENABLED !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+
+// Уровни подробности: сообщение выводится, если его уровень не выше mel.Debug.Verbosity
+enum class EMelDebugVerbosity : uint8
+{
+    Error = 1,   // Ошибки настройки и данных
+    Info = 2,    // События боя: обнаружения, выстрелы, попадания
+    Verbose = 3  // Состояние каждый кадр: ожидание перезарядки, выбор цели, список угроз
+};
+
+#if MEL_DEBUG_ENABLED
+
+class MEL_API FMelDebug
+{
+public:
+    // Ключ сообщения: место вызова и контекст (актор, пара актор-номер и т.п.)
+    template <typename ContextType>
+    static uint32 MakeKey(const void* Site, const ContextType& Context)
+    {
+        return HashCombineFast(GetTypeHash(Site), GetTypeHash(Context));
+    }
+
+    // Пройдет ли сообщение: уровень подробности и не чаще раза за Duration на ключ.
+    // Отброшенные повторы считаются и дописываются к следующему выводу.
+    static bool ShouldPrint(uint32 Key, EMelDebugVerbosity Verbosity, float Duration);
+
+    // Вывести сообщение; сообщение с тем же ключом заменяет предыдущее на экране
+    static void Print(uint32 Key, float Duration, const FColor& Color, FString&& Message);
+};
+
+// MEL_DEBUG(Verbosity, Context, Duration, Color, Format, ...)
+// Строка форматируется только если сообщение прошло фильтр. Повторы с тем же местом вызова
+// и контекстом за время показа (Duration) не выводятся, а копятся счетчиком.
+#define MEL_DEBUG(Verbosity, Context, Duration, Color, Format, ...) \
+    do \
+    { \
+        static const uint8 MelDebugSite = 0; \
+        const uint32 MelDebugKey = FMelDebug::MakeKey(&MelDebugSite, Context); \
+        if (FMelDebug::ShouldPrint(MelDebugKey, EMelDebugVerbosity::Verbosity, Duration)) \
+        { \
+            FMelDebug::Print(MelDebugKey, Duration, Color, FString::Printf(Format, ##__VA_ARGS__)); \
+        } \
+    } while (0)
+
+#else
+
+#define MEL_DEBUG(Verbosity, Context, Duration, Color, Format, ...) do { } while (0)
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "MelPoolable.generated.h"
+
+UINTERFACE(MinimalAPI)
+class UMelPoolable : public UInterface
+{
+    GENERATED_BODY()
+};
+
+// Актор, переиспользуемый через UMelActorPoolSubsystem.
+// Оба вызова должны быть идемпотентны: при прогреве пула OnReleasedToPool вызывается еще до BeginPlay.
+class MEL_API IMelPoolable
+{
+    GENERATED_BODY()
+
+public:
+    // Актор выдан из пула: трансформ и владелец уже установлены, видимость, коллизия и тик включены
+    virtual void OnAcquiredFromPool() {}
+
+    // Актор возвращается в пул: сбросить состояние полета и отписаться от подсистем
+    virtual void OnReleasedToPool() {}
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sim/MelSimMath.h"
+
+// Преобразования между типами движка и ядра симуляции
+namespace MelSim
+{
+    FORCEINLINE FVec3 ToSim(const FVector& V)
+    {
+        return FVec3(static_cast<float>(V.X), static_cast<float>(V.Y), static_cast<float>(V.Z));
+    }
+
+    FORCEINLINE FVector ToUE(const FVec3& V)
+    {
+        return FVector(V.X, V.Y, V.Z);
+    }
+}
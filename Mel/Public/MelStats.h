@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// Статистика Mel: "stat Mel" в игре, те же области - в Unreal Insights: SCOPE_CYCLE_COUNTER сам пишет
+// область трассы с именем счетчика, отдельные TRACE_CPUPROFILER_EVENT_SCOPE не нужны.
+// Счетчики времени стоят на проходах за кадр или шаг боя, а не на отдельных ракетах и треках;
+// проходы, выполняемые на рабочих потоках, видны в своих потоках.
+DECLARE_STATS_GROUP(TEXT("Mel"), STATGROUP_Mel, STATCAT_Advanced);
+
+// Шаг боя целиком (фиксированные часы)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Engagement step"), STAT_MelEngagementStep, STATGROUP_Mel, MEL_API);
+
+// Радары
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar step"), STAT_MelRadarStep, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar azimuth refresh"), STAT_MelRadarAzimuthRefresh, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar scan"), STAT_MelRadarScan, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar update missile data"), STAT_MelRadarUpdateMissileData, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar track filter and threat"), STAT_MelRadarTrackFilter, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar report"), STAT_MelRadarReport, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar track cleanup"), STAT_MelRadarCleanup, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar network scan"), STAT_MelRadarNetworkScan, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Radar track fusion"), STAT_MelRadarFusion, STATGROUP_Mel, MEL_API);
+
+// Ракеты
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Missile step"), STAT_MelMissileStep, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Missile batch kernel"), STAT_MelMissileBatch, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Missile target collision"), STAT_MelMissileCollision, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Missile significance"), STAT_MelMissileSignificance, STATGROUP_Mel, MEL_API);
+
+// ПВО
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fire control"), STAT_MelFireControl, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile step"), STAT_MelProjectileStep, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile guidance"), STAT_MelProjectileGuidance, STATGROUP_Mel, MEL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile collision"), STAT_MelProjectileCollision, STATGROUP_Mel, MEL_API);
+
+// Счетчики: треки, ракеты и снаряды в полете - текущее значение; сканы, выстрелы и попадания - за кадр
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Radar tracks"), STAT_MelRadarTracks, STATGROUP_Mel, MEL_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active missiles"), STAT_MelActiveMissiles, STATGROUP_Mel, MEL_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active projectiles"), STAT_MelActiveProjectiles, STATGROUP_Mel, MEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Radar scans"), STAT_MelRadarScans, STATGROUP_Mel, MEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AA shots"), STAT_MelShots, STATGROUP_Mel, MEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AA hits"), STAT_MelHits, STATGROUP_Mel, MEL_API);
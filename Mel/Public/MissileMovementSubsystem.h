@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Sim/MelSimMissileBatch.h"
+#include "Sim/MelSimTrajectory.h"
+#include "MissileMovementSubsystem.generated.h"
+
+class AMissleActor;
+
+// Пакетное движение ракет. Состояние всех ракет хранится в SoA-буферах MelSim::FMissileBatch,
+// за кадр выполняется один векторизованный шаг, затем трансформы записываются в акторы одним проходом.
+// Для каждой ракеты хранится кусочно-аналитический прогноз траектории (MelSim::FMissileTrajectory),
+// он перестраивается только при смене фазы полета. Время прогноза - время боя.
+// Шаги выполняет UEngagementClockSubsystem, в Tick обновляется только статистика.
+UCLASS()
+class MEL_API UMissileMovementSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Шаг всех ракет: пакетное движение, запись в акторы, взрывы
+    void StepMissiles(float DeltaTime);
+
+    // Возвращает идентификатор ракеты в пакете
+    int32 RegisterMissile(AMissleActor* Missile, const MelSim::FMissileState& State, const MelSim::FMissileParams& Params);
+    void UnregisterMissile(int32 MissileId);
+
+    // Текущее состояние и параметры ракеты для прогноза траектории; false, если ракеты нет в пакете
+    bool GetMissileState(int32 MissileId, MelSim::FMissileState& OutState, MelSim::FMissileParams& OutParams) const;
+
+    // Прогноз траектории ракеты или nullptr, если ракеты нет в пакете
+    const MelSim::FMissileTrajectory* GetTrajectory(int32 MissileId) const;
+
+    // Время до падения и точка падения по прогнозу - O(1); false, если ракеты нет в пакете
+    bool PredictImpact(int32 MissileId, float Now, float& OutTimeToImpact, FVector& OutImpactPoint) const;
+
+    int32 GetNumMissiles() const { return Batch.Num(); }
+
+    // Наибольшая скорость ракеты на последнем шаге: запас для запросов сближения за шаг
+    float GetMaxMissileSpeed() const { return MaxMissileSpeed; }
+    const MelSim::FMissileBatch& GetBatch() const { return Batch; }
+
+    // Летящие ракеты по плотному индексу пакета (порядок меняется при снятии ракеты)
+    const TArray<AMissleActor*>& GetMissiles() const { return Missiles; }
+
+private:
+    MelSim::FMissileBatch Batch;
+
+    // Акторы по плотному индексу пакета
+    TArray<AMissleActor*> Missiles;
+
+    // Прогнозы траекторий по плотному индексу пакета
+    TArray<MelSim::FMissileTrajectory> Trajectories;
+
+    // Ракеты, достигшие цели за текущий кадр (взрываются после прохода записи)
+    TArray<AMissleActor*> ExplodingMissiles;
+
+    float MaxMissileSpeed = 0.0f;
+};
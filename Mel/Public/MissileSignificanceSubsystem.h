@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MissileSignificanceSubsystem.generated.h"
+
+class AMissleActor;
+
+// Значимость ракет для отображения. Каждый кадр переоценивается порция летящих ракет
+// (mel.Significance.UpdatesPerFrame, по кругу): оценка - ближе к камере или в зоне обзора радара,
+// плюс надбавка за фазу снижения и взлета. По оценке ракете назначается EMissileSignificance:
+// частота поворота, звук пуска и детализация меша. Позиция и полет от значимости не зависят.
+UCLASS()
+class MEL_API UMissileSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    // Следующий плотный индекс ракеты для переоценки
+    int32 Cursor = 0;
+
+    // Точки обзора локальных игроков, собираются раз за кадр
+    TArray<FVector> Viewpoints;
+
+    void GatherViewpoints();
+    float GetScore(const AMissleActor* Missile) const;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MissileSpatialSubsystem.generated.h"
+
+class AMissleActor;
+
+// Сектор обзора радара: горизонтальная дальность, азимут (градусы) и диапазон высот
+struct FRadarSectorQuery
+{
+    FVector Origin = FVector::ZeroVector;
+    float Radius = 0.0f;
+    float CenterAngleDeg = 0.0f;
+    float WidthDeg = 0.0f;
+    float MinHeight = 0.0f;
+    float MaxHeight = 0.0f;
+
+    // Время, на которое положения целей отматываются назад (под-скан, опоздавший относительно
+    // своего момента). Учитывается азимутальным индексом радара.
+    float Age = 0.0f;
+};
+
+// Предрасчитанная проверка попадания точки в сектор
+struct MEL_API FRadarSectorTest
+{
+    FVector2D Origin2D;
+    FVector2D Axis;
+    float RadiusSquared;
+    float CosHalfWidth;
+    float MinHeight;
+    float MaxHeight;
+
+    explicit FRadarSectorTest(const FRadarSectorQuery& Query);
+    bool Contains(const FVector& Location) const;
+};
+
+// Пространственный индекс живых ракет (равномерная сетка по XY).
+// Ракеты регистрируются в BeginPlay, обновляют свою ячейку раз в кадр из Tick
+// и удаляются в EndPlay, поэтому запросы не обходят весь список акторов мира.
+UCLASS()
+class MEL_API UMissileSpatialSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    void RegisterMissile(AMissleActor* Missile);
+    void UnregisterMissile(AMissleActor* Missile);
+
+    // Обновить положение ракеты в индексе (раз в кадр из AMissleActor::Tick)
+    void UpdateMissile(AMissleActor* Missile);
+
+    // Ракеты внутри сферы
+    void QueryRadius(const FVector& Center, float Radius, TArray<AMissleActor*>& OutMissiles) const;
+
+    // Ракеты внутри AABB
+    void QueryBox(const FBox& Box, TArray<AMissleActor*>& OutMissiles) const;
+
+    // Ракеты внутри сектора радара
+    void QuerySector(const FRadarSectorQuery& Query, TArray<AMissleActor*>& OutMissiles) const;
+
+    // Все ячейки (в том числе пустые), которые покрывает горизонтальный круг
+    void GetCellsInRadius(const FVector& Center, float Radius, TArray<FIntPoint>& OutCells) const;
+
+    // Обойти ракеты одной ячейки: Visitor(AMissleActor*, const FVector& Location)
+    template <typename VisitorType>
+    void ForEachInCell(const FIntPoint& Cell, VisitorType&& Visitor) const;
+
+    // Последнее записанное положение ракеты; false, если ракеты нет в индексе
+    bool GetMissileLocation(AMissleActor* Missile, FVector& OutLocation) const;
+
+    int32 GetNumMissiles() const { return MissileCells.Num(); }
+
+private:
+    struct FCellEntry
+    {
+        AMissleActor* Missile;
+        FVector Location;
+    };
+
+    struct FCellRef
+    {
+        FIntPoint Cell;
+        int32 Slot;
+    };
+
+    // Размер ячейки сетки (см)
+    static constexpr float CellSize = 5000.0f;
+
+    TMap<FIntPoint, TArray<FCellEntry>> Cells;
+    TMap<AMissleActor*, FCellRef> MissileCells;
+
+    FIntPoint GetCell(const FVector& Location) const;
+    void AddToCell(AMissleActor* Missile, const FVector& Location, const FIntPoint& Cell);
+    void RemoveFromCell(const FCellRef& Ref);
+
+    template <typename PredicateType>
+    void ForEachInRect(const FVector2D& Min, const FVector2D& Max, PredicateType&& Predicate) const;
+};
+
+template <typename VisitorType>
+void UMissileSpatialSubsystem::ForEachInCell(const FIntPoint& Cell, VisitorType&& Visitor) const
+{
+    if (const TArray<FCellEntry>* Entries = Cells.Find(Cell))
+    {
+        for (const FCellEntry& Entry : *Entries)
+        {
+            Visitor(Entry.Missile, Entry.Location);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MissileWaveSubsystem.generated.h"
+
+class AMissleActor;
+
+// Порядок пусков внутри волны
+UENUM(BlueprintType)
+enum class EMissileArrivalPattern : uint8
+{
+    Instant,   // Все ракеты сразу (пуски все равно распределяются по кадрам бюджетом)
+    Uniform,   // Равные интервалы MeanInterval
+    Poisson,   // Случайные интервалы со средним MeanInterval (экспоненциальное распределение)
+    Salvo      // Залпы по SalvoSize ракет через MeanInterval, ракеты залпа - через SalvoSpread
+};
+
+USTRUCT(BlueprintType)
+struct FMissileWave
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave")
+    int32 Count = 10;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave")
+    float StartDelay = 0.0f; // Секунды боя от постановки волны до первого пуска
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave")
+    EMissileArrivalPattern Pattern = EMissileArrivalPattern::Uniform;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave")
+    float MeanInterval = 0.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave")
+    int32 SalvoSize = 4;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave")
+    float SalvoSpread = 0.1f;
+};
+
+// Планировщик волн ракет. Волна превращается в очередь пусков по времени боя. Наступившие пуски
+// выполняет часы боя в начале шага (LaunchDueMissiles), поэтому шаг пуска зависит только от времени боя,
+// а не от частоты кадров или скорости машины, и повтор журнала (-MelReplay) сходится.
+// Точки пуска берутся из генератора часов боя при постановке волны.
+// Ракеты выдаются из пула. Бюджет кадра mel.Spawn.FrameBudgetMs тратится только на создание
+// акторов для ожидающих пусков в Tick; bPrewarm создает их сразу при постановке волны (на загрузке уровня).
+// Если к пуску актора в пуле нет, он создается в шаге пуска - бюджет никогда не сдвигает пуск.
+UCLASS()
+class MEL_API UMissileWaveSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Поставить волну в очередь; MakeLaunchPoint вызывается для каждой ракеты сразу
+    void ScheduleWave(TSubclassOf<AMissleActor> MissileClass, const FMissileWave& Wave,
+                      TFunctionRef<FVector()> MakeLaunchPoint, AActor* Owner = nullptr, bool bPrewarm = true);
+
+    // Пуски, ожидающие своего времени
+    int32 GetNumPending() const { return PendingLaunches.Num(); }
+
+    // Запустить пуски, время которых наступило (вызывается часами боя перед шагом ракет)
+    void LaunchDueMissiles();
+
+private:
+    struct FPendingLaunch
+    {
+        float LaunchTime = 0.0f;
+        int32 Sequence = 0; // Порядок постановки: равные по времени пуски выходят в нем
+        TSubclassOf<AMissleActor> MissileClass;
+        FVector Location = FVector::ZeroVector;
+        TWeakObjectPtr<AActor> Owner;
+
+        bool operator<(const FPendingLaunch& Other) const
+        {
+            return LaunchTime < Other.LaunchTime || (LaunchTime == Other.LaunchTime && Sequence < Other.Sequence);
+        }
+    };
+
+    // Куча по времени пуска
+    TArray<FPendingLaunch> PendingLaunches;
+    int32 NextSequence = 0;
+
+    // Ожидающие пуски по классу ракеты: сколько акторов пул должен создать заранее
+    TMap<UClass*, int32> NumPendingByClass;
+
+    float GetLaunchOffset(const FMissileWave& Wave, int32 Index, float PreviousOffset, FRandomStream& Random) const;
+    void Launch(const FPendingLaunch& Pending);
+};
@@ -3,8 +3,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "GameFramework/ProjectileMovementComponent.h"
+#include "MelPoolable.h"
 #include "MissleActor.generated.h"
 
+class UMissileSpatialSubsystem;
+class UMissileMovementSubsystem;
+class URadarNetworkSubsystem;
+class UEngagementClockSubsystem;
+
 UENUM(BlueprintType)
 enum class EMisslePhase : uint8
 {
@@ -14,18 +20,47 @@ enum class EMisslePhase : uint8
     Descent       // Плавное снижение к цели
 };
 
+// Значимость ракеты для отображения (назначает UMissileSignificanceSubsystem).
+// Меняет только частоту поворота, звук и детализацию меша - полет от нее не зависит.
+UENUM(BlueprintType)
+enum class EMissileSignificance : uint8
+{
+    High,     // Поворот каждый шаг, полный меш
+    Medium,   // Поворот раз в MediumRotationInterval
+    Low       // Поворот раз в LowRotationInterval, без звука пуска, младший LOD без теней
+};
+
 UCLASS()
-class MEL_API AMissleActor : public AActor
+class MEL_API AMissleActor : public AActor, public IMelPoolable
 {
     GENERATED_BODY()
 
 public:
     AMissleActor();
 
-    virtual void Tick(float DeltaTime) override;
+    EMisslePhase GetPhase() const { return Phase; }
+    const FVector& GetCurrentVelocity() const { return CurrentVelocity; }
+
+    // Идентификатор в пакете UMissileMovementSubsystem (INDEX_NONE, если ракета не летит)
+    int32 GetMovementId() const { return MovementId; }
+
+    // Ракета летит (не лежит свободной в пуле)
+    bool IsInFlight() const { return MovementId != INDEX_NONE; }
+
+    // Номер запуска: меняется при каждом выходе из пула, по нему снаряды отличают
+    // свою цель от того же актора, запущенного заново
+    int32 GetLaunchSerial() const { return LaunchSerial; }
+
+    EMissileSignificance GetSignificance() const { return Significance; }
+    void SetSignificance(EMissileSignificance NewSignificance);
+
+    // IMelPoolable
+    virtual void OnAcquiredFromPool() override;
+    virtual void OnReleasedToPool() override;
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UStaticMeshComponent* Mesh;
@@ -72,17 +107,44 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flight")
     float MinTargetDistance = 5000.f;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float MediumRotationInterval = 0.1f; // Секунды между поворотами ракеты средней значимости
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float LowRotationInterval = 0.5f; // Секунды между поворотами ракеты низкой значимости
+
 private:
-    void UpdateRotation(float DeltaTime);
+    friend class UMissileMovementSubsystem;
+
+    // Применить результат пакетного шага. Возвращает true, если ракета врезалась в геометрию мира
+    // (достижение точки цели без геометрии проверяет подсистема движения по пакету).
+    bool ApplyBatchedMovement(const FVector& NewLocation, const FVector& NewVelocity, EMisslePhase NewPhase, float DeltaTime);
+
+    // Направление носа по фазе и скорости; отображаемый поворот догоняет его с RotationSpeed
+    FRotator GetTargetRotation() const;
+    FRotator CalculateRotation(float DeltaTime) const;
     bool CheckTargetCollision();
     void Explode();
 
+    // Запуск из текущего положения и снятие с полета (регистрация в подсистемах, звук)
+    void StartFlight();
+    void StopFlight();
+
+    // Состояние полета ведет UMissileMovementSubsystem, актор хранит копию для отображения
     EMisslePhase Phase;
-    FVector InitialDirection;
-    FVector TargetDirection;
-    FVector TargetPoint;
     FVector CurrentVelocity;
-    float CurrentTransitionTime;
-    FVector HorizontalStartPoint; // Точка начала горизонтального полета
-    FVector HorizontalEndPoint;   // Точка окончания горизонтального полета
+    int32 MovementId;
+    int32 LaunchSerial;
+
+    EMissileSignificance Significance;
+    float RotationUpdateInterval;
+    float TimeSinceRotationUpdate;
+
+    // Ракета создана пулом и ждет Acquire - BeginPlay не запускает полет
+    bool bPooledIdle;
+
+    UMissileSpatialSubsystem* SpatialIndex;
+    UMissileMovementSubsystem* MovementSystem;
+    URadarNetworkSubsystem* RadarNetwork;
+    UEngagementClockSubsystem* EngagementClock;
 };
@@ -15,7 +15,6 @@ protected:
     virtual void BeginPlay() override;
 
 public:
-    void SpawnMissle();
     FVector GetRandomEdgePosition(float DistanceFromCenter);
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Missle")
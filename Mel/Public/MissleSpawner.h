@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "MissileWaveSubsystem.h"
 #include "MissleSpawner.generated.h"
 
 UCLASS()
@@ -25,7 +26,15 @@ public:
     TSubclassOf<class AMissleActor> MissleClass;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Missile")
-    int32 MissleCount = 3;
+    int32 MissleCount = 3; // Если волны не заданы - одна волна из стольких ракет сразу
+
+    // Волны ставятся в очередь UMissileWaveSubsystem в BeginPlay, задержки - от начала игры
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Missile")
+    TArray<FMissileWave> Waves;
+
+    // Создать ракеты волн в пуле при загрузке
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Missile")
+    bool bPrewarmWaves = true;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
     float MapHalfSize = 30000.f;
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Sim/MelSimProjectileBatch.h"
+#include "ProjectileGuidanceSubsystem.generated.h"
+
+class AAAProjectileActor;
+class AMissleActor;
+class UMissileSpatialSubsystem;
+class UMissileMovementSubsystem;
+
+// Пакетное наведение снарядов ПВО. Все снаряды в полете лежат в MelSim::FProjectileBatch:
+// за шаг цели снимаются на игровом потоке, прямой полет и наведение считаются одним проходом
+// (на рабочих потоках при mel.Projectile.ParallelGuidance), затем трансформы записываются в акторы,
+// а попадания и подрывы по близости обрабатываются одним проходом. Попадания и подрывы проверяются
+// по наименьшему сближению снаряда и ракеты за весь шаг, поэтому не зависят от частоты шагов.
+// Акторы снарядов не тикают.
+// Шаги выполняет UEngagementClockSubsystem, в Tick обновляется только статистика.
+UCLASS()
+class MEL_API UProjectileGuidanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Шаг всех снарядов: снимок целей, наведение, запись в акторы, попадания
+    void StepProjectiles(float DeltaTime);
+
+    // Возвращает идентификатор снаряда в пакете. Target может быть nullptr - снаряд летит прямо.
+    int32 RegisterProjectile(AAAProjectileActor* Projectile, const MelSim::FProjectileState& State, AMissleActor* Target);
+    void UnregisterProjectile(int32 ProjectileId);
+
+    int32 GetNumProjectiles() const { return Batch.Num(); }
+
+    // Обойти снаряды, чья цель еще летит: цель и состояние полета
+    void VisitTargetedProjectiles(TFunctionRef<void(AMissleActor*, const MelSim::FProjectileState&)> Visitor) const;
+
+private:
+    // Цель снаряда: ракета и номер ее запуска на момент выстрела
+    struct FProjectileTarget
+    {
+        AMissleActor* Missile = nullptr;
+        int32 LaunchSerial = 0;
+    };
+
+    // Снаряд, закончивший полет за шаг: Missile - пораженная ракета или nullptr (время вышло)
+    struct FFinishedProjectile
+    {
+        AAAProjectileActor* Projectile = nullptr;
+        FProjectileTarget Hit;
+        bool bProximity = false;
+    };
+
+    MelSim::FProjectileBatch Batch;
+
+    // Акторы, цели и предел времени полета по плотному индексу пакета
+    TArray<AAAProjectileActor*> Projectiles;
+    TArray<FProjectileTarget> Targets;
+    TArray<float> MaxFlightTimes;
+
+    TArray<FFinishedProjectile> FinishedProjectiles;
+    TArray<AMissleActor*> FoundMissiles;
+
+    UMissileSpatialSubsystem* SpatialIndex;
+    UMissileMovementSubsystem* MovementSystem;
+
+    // Ракета еще летит и это тот же запуск
+    static bool IsTargetAlive(const FProjectileTarget& Target);
+};
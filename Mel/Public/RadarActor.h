@@ -4,56 +4,16 @@
 #include "GameFramework/Actor.h"
 #include "Components/AudioComponent.h"
 #include "GameFramework/MovementComponent.h"
+#include "Sim/MelSimRadar.h"
+#include "MissileSpatialSubsystem.h"
+#include "RadarTrackTable.h"
+#include "RadarAzimuthIndex.h"
 #include "RadarActor.generated.h"
 
 class AMissleActor;
-
-// Структура для хранения информации о ракете
-USTRUCT(BlueprintType)
-struct FMissileData
-{
-    GENERATED_BODY()
-
-    UPROPERTY(BlueprintReadWrite)
-    AActor* Missile;
-
-    UPROPERTY(BlueprintReadWrite)
-    FVector Position;
-
-    UPROPERTY(BlueprintReadWrite)
-    FVector Velocity;
-
-    UPROPERTY(BlueprintReadWrite)
-    FVector PredictedPosition;
-
-    UPROPERTY(BlueprintReadWrite)
-    float Distance;
-
-    UPROPERTY(BlueprintReadWrite)
-    float ThreatLevel;
-
-    UPROPERTY(BlueprintReadWrite)
-    float LastDetectionTime;
-
-    UPROPERTY(BlueprintReadWrite)
-    int32 DetectionCount;
-
-    UPROPERTY(BlueprintReadWrite)
-    bool bReportedTrajectory;
-
-    FMissileData()
-    {
-        Missile = nullptr;
-        Position = FVector::ZeroVector;
-        Velocity = FVector::ZeroVector;
-        PredictedPosition = FVector::ZeroVector;
-        Distance = 0.0f;
-        ThreatLevel = 0.0f;
-        LastDetectionTime = 0.0f;
-        DetectionCount = 0;
-        bReportedTrajectory = false;
-    }
-};
+class URadarNetworkSubsystem;
+class UEngagementClockSubsystem;
+class UMissileMovementSubsystem;
 
 UCLASS()
 class MEL_API ARadarActor : public AActor
@@ -63,14 +23,33 @@ class MEL_API ARadarActor : public AActor
 public:
     ARadarActor();
 
+    // Только отрисовка луча: шаги радара выполняют часы боя, тик идет после шага (TG_PostPhysics)
     virtual void Tick(float DeltaTime) override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // Публичный аксессор для ПВО
-    const TArray<FMissileData>& GetDetectedMissiles() const { return DetectedMissiles; }
+    const TArray<FMissileData>& GetDetectedMissiles() const { return Tracks.GetTracks(); }
+
+    float GetScanRadius() const { return ScanRadius; }
+
+    // Подтвержденные треки для range-for, без выделения памяти. Подтверждает сеть радаров
+    // по сумме обнаружений ракеты всеми радарами (URadarNetworkSubsystem::ConfirmTracks).
+    // Список ведется при подтверждении и удалении треков, а не собирается при запросе.
+    // Треки есть только у летящих ракет: ракета, снятая с полета, забывается всеми радарами.
+    FRadarConfirmedTrackView GetConfirmedTracks() const { return Tracks.GetConfirmed(); }
+
+    // Ракета трека (треки заводятся только для AMissleActor)
+    static AMissleActor* GetTrackMissile(const FMissileData& MissileData);
 
-    // Получить ракеты, обнаруженные 3 раза
-    TArray<AMissleActor*> GetMissilesDetectedThreeTimes() const;
+    // Обойти подтвержденные треки
+    void VisitConfirmedTracks(TFunctionRef<void(AMissleActor*, const FMissileData&)> Visitor) const;
+
+    // Обойти подтвержденные треки, оценка положения которых ближе Radius к Origin
+    void VisitConfirmedTracksInRange(const FVector& Origin, float Radius, TFunctionRef<void(AMissleActor*, const FMissileData&)> Visitor) const;
+
+    // Забыть трек ракеты (ракета снята с полета и может вернуться из пула новой целью)
+    void ForgetMissile(AMissleActor* Missile);
 
 protected:
     UPROPERTY(EditAnywhere, Category = "Radar Settings")
@@ -103,6 +82,25 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Radar Settings")
     float ThreatHeightWeight = 0.3f; // Вес высоты в расчете угрозы
 
+    UPROPERTY(EditAnywhere, Category = "Radar Settings")
+    float MaxTargetSpeed = 3000.0f; // Максимальная скорость цели для азимутального индекса (см/с)
+
+    UPROPERTY(EditAnywhere, Category = "Radar Settings")
+    bool bSweptScan = true; // Проверять весь сектор, пройденный лучом, с фиксированным шагом (не зависит от FPS)
+
+    UPROPERTY(EditAnywhere, Category = "Radar Settings")
+    float TrackFilterDiscount = 0.3f; // Сглаживание фильтра треков: 0 - по последним обнаружениям, ближе к 1 - сильнее
+
+    // Дальше этой дальности треки неопасных ракет обновляются реже и без прогноза траектории (0 - всегда полностью)
+    UPROPERTY(EditAnywhere, Category = "Radar LOD")
+    float FullDetailRange = 15000.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Radar LOD")
+    float FullDetailThreat = 0.5f; // С угрозой не ниже трек обновляется полностью на любой дальности
+
+    UPROPERTY(EditAnywhere, Category = "Radar LOD")
+    float FarTrackUpdateInterval = 0.25f; // Период обновления трека дальней зоны (сек)
+
     UPROPERTY(EditAnywhere, Category = "Radar Settings")
     USoundBase* PingSound;
 
@@ -110,20 +108,66 @@ protected:
     UAudioComponent* AudioComponent;
 
 private:
+    // Сеть радаров выполняет сканы в параллельном режиме
+    friend class URadarNetworkSubsystem;
+
+    // Событие обнаружения, накопленное за скан (выводится на игровом потоке)
+    struct FDetectionEvent
+    {
+        int32 RocketNumber;
+        int32 DetectionCount;
+        int32 TrackIndex; // Трек, из оценки которого событие получает положение и скорость
+        FVector Position;
+        FVector Velocity;
+        bool bImpactPredicted; // Ракеты нет в пакете движения - прогноза падения нет
+        float TimeToGround;
+        FVector ImpactPoint;
+    };
+
     float CurrentScanAngle;
     float TimeSinceLastScan;
-    TArray<FMissileData> DetectedMissiles;
-    TMap<AActor*, float> MissileLastDetectionTimes;
-
+    FRadarTrackTable Tracks;
+    FRadarAzimuthIndex AzimuthIndex;
+    UMissileSpatialSubsystem* SpatialIndex;
+    URadarNetworkSubsystem* RadarNetwork;
+    UMissileMovementSubsystem* MovementSystem;
+    MelSim::FSweepClock SweepClock;
+
+    // Сектора, ожидающие проверки (под-сканы текущего кадра)
+    TArray<FRadarSectorQuery> PendingScanQueries;
+    TArray<FDetectionEvent> PendingEvents;
+
+    // Обнаружения скана для пакетного обновления фильтров треков
+    TArray<MelSim::FTrackMeasurement> PendingMeasurements;
+
+    // Ракеты неподтвержденных треков, получивших засчитанное обнаружение (подтверждение решает сеть)
+    TArray<AMissleActor*> PendingConfirmations;
+
+    // Параметры для расчетов ядра симуляции (копируются из настроек в BeginPlay)
+    MelSim::FRadarParams SimParams;
+
+    // Поворот луча, постановка под-сканов и последовательный скан.
+    // Вызывается часами боя из URadarNetworkSubsystem::StepRadars; треки очищаются там же после сканов.
+    void StepEngagement(float DeltaTime);
+
+    // Скан делится на этапы: RunPendingScans меняет только треки этого радара
+    // и может выполняться на рабочем потоке, FinishScan выводит события на игровом потоке.
+    // Сеть радаров отбирает кандидатов сама и передает их в ProcessScanCandidates,
+    // после чего CompletePendingScans обновляет фильтры треков и снимает под-сканы.
     void PerformScan();
-    void CalculateImpactPoint(const FMissileData& MissileData);
-    bool IsMissileInScanSector(const FVector& MissileLocation);
+    void RunPendingScans(float CurrentTime, TArray<AMissleActor*>& Candidates);
+    void CompletePendingScans(float CurrentTime);
+    FRadarSectorQuery MakeScanQuery(float CenterAngleDeg, float WidthDeg, float Age) const;
+    void ProcessScanCandidates(const TArray<AMissleActor*>& Candidates, float CurrentTime);
+    void ApplyMeasurements(float CurrentTime);
+    void FinishScan();
     void PlayPingSound();
-    void UpdateMissileData(AActor* Missile);
+    void UpdateMissileData(AMissleActor* Missile, float CurrentTime);
     void PredictMissileTrajectory(FMissileData& MissileData);
     float CalculateThreatLevel(const FMissileData& MissileData);
     void CleanupOldDetections();
-    void SortMissilesByThreat();
-    bool IsMissileInHeightRange(const FVector& MissileLocation);
-    float CalculateTimeToImpact(const FMissileData& MissileData);
+
+    // Время до падения и точка падения по прогнозу траектории ракеты из подсистемы движения.
+    // false - ракета не зарегистрирована в пакете, прогноза нет
+    bool PredictImpact(const FMissileData& MissileData, float CurrentTime, float& OutTimeToImpact, FVector& OutImpactPoint) const;
 }; 
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissileSpatialSubsystem.h"
+
+// Ракеты в зоне радара, разложенные по азимутальным корзинам относительно радара.
+// Скан обходит только корзины, перекрывающие луч, и ближнюю зону, а затем точно проверяет кандидатов,
+// поэтому его стоимость пропорциональна целям в луче, а не всем ракетам.
+//
+// Корзины обновляются по кругу: за RefreshPeriod каждая корзина перепроверяется хотя бы раз,
+// а ячейки пространственного индекса в зоне просматриваются в поисках новых ракет.
+// Пока запись не обновлена, ракета могла сместиться по азимуту; при скорости не выше MaxTargetSpeed
+// дальше NearRadius сдвиг меньше одной корзины, поэтому запрос берет по одной соседней корзине с каждой стороны,
+// а ракеты ближе NearRadius хранятся отдельно и проверяются на каждом скане.
+class MEL_API FRadarAzimuthIndex
+{
+public:
+    void Initialize(const UMissileSpatialSubsystem& SpatialIndex, const FVector& InOrigin, float InRadius, float InMaxTargetSpeed);
+
+    // Обновить часть корзин и ячеек пропорционально прошедшему времени
+    void Refresh(const UMissileSpatialSubsystem& SpatialIndex, float DeltaTime);
+
+    // Ракеты внутри сектора. Только читает индексы и безопасен для рабочих потоков.
+    void QuerySector(const UMissileSpatialSubsystem& SpatialIndex, const FRadarSectorQuery& Query, TArray<AMissleActor*>& OutMissiles) const;
+
+    // Тот же запрос по частям: корзины сектора в порядке QuerySector (ближняя зона первой)
+    // и ракеты сектора из одной корзины. Части можно проверять на разных потоках,
+    // а склеенные в порядке корзин результаты совпадают с QuerySector.
+    void GetSectorBuckets(const FRadarSectorQuery& Query, TArray<int32>& OutBuckets) const;
+    void QuerySectorBucket(const UMissileSpatialSubsystem& SpatialIndex, const FRadarSectorQuery& Query, int32 Bucket, TArray<AMissleActor*>& OutMissiles) const;
+
+    // Убрать ракету сразу, не дожидаясь обновления ее корзины (ракета вернулась в пул)
+    void Remove(AMissleActor* Missile);
+
+    int32 Num() const { return Known.Num(); }
+
+private:
+    static constexpr int32 NumBuckets = 72;
+    static constexpr float BucketWidthDeg = 360.0f / NumBuckets;
+
+    // Полный круг обновления корзин и поиска новых ракет (сек)
+    static constexpr float RefreshPeriod = 0.1f;
+
+    // Корзина ближней зоны идет после азимутальных
+    static constexpr int32 NearBucket = NumBuckets;
+
+    FVector Origin;
+    float Radius;
+    float MaxTargetSpeed;
+
+    // Ракеты дальше этого радиуса (с учетом запаса на движение) удаляются из индекса
+    float TrackRadius;
+
+    // Ближе этого радиуса азимут может сместиться больше чем на корзину
+    float NearRadius;
+
+    TArray<TArray<AMissleActor*>> Buckets;
+    TSet<AMissleActor*> Known;
+
+    // Ячейки пространственного индекса в зоне радара
+    TArray<FIntPoint> Cells;
+
+    int32 NextBucket = 0;
+    int32 NextCell = 0;
+    float BucketBudget = 0.0f;
+    float CellBudget = 0.0f;
+
+    int32 GetBucket(const FVector& Location) const;
+    void RefreshBucket(const UMissileSpatialSubsystem& SpatialIndex, int32 Bucket);
+    void DiscoverInCell(const UMissileSpatialSubsystem& SpatialIndex, const FIntPoint& Cell);
+    void TestBucket(const UMissileSpatialSubsystem& SpatialIndex, const FRadarSectorQuery& Query, const FRadarSectorTest& Sector,
+                    int32 Bucket, TArray<AMissleActor*>& OutMissiles) const;
+
+    template <typename FuncType>
+    void ForEachSectorBucket(const FRadarSectorQuery& Query, FuncType&& Func) const;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MissileSpatialSubsystem.h"
+#include "Sim/MelSimTrackFilter.h"
+#include "RadarNetworkSubsystem.generated.h"
+
+class ARadarActor;
+class AMissleActor;
+
+// Слитый трек сети: одна ракета по трекам всех радаров, которые ее видят
+struct FRadarFusedTrack
+{
+    AMissleActor* Missile = nullptr;
+    FVector Position = FVector::ZeroVector; // Оценка на момент запроса картины
+    FVector Velocity = FVector::ZeroVector;
+    float ThreatLevel = 0.0f;               // Наибольшая угроза по радарам
+};
+
+// Сеть радаров мира. В параллельном режиме (mel.Radar.ParallelScan) радары только запрашивают скан,
+// а подсистема выполняет сканы всех радаров за кадр на рабочих потоках ParallelFor: сначала кандидаты
+// отбираются по частям (под-скан и азимутальная корзина радара - отдельная задача), затем каждый радар
+// обновляет свои треки по кандидатам частей в порядке под-сканов и корзин.
+// Сообщения и звук выводятся после слияния на игровом потоке в порядке регистрации радаров,
+// поэтому результат не зависит от числа потоков и совпадает с последовательным сканом.
+// Ракету подтверждает сеть: обнаружения ее треков всеми радарами складываются (ConfirmTracks),
+// поэтому ракета в зоне нескольких радаров подтверждается быстрее.
+// Подтвержденные треки сливаются в общую картину (GetFusedTracks): треки одной ракеты объединяются,
+// оценки приводятся к общему моменту (MelSim::FTrackFusion).
+UCLASS()
+class MEL_API URadarNetworkSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void RegisterRadar(ARadarActor* Radar);
+    void UnregisterRadar(ARadarActor* Radar);
+
+    const TArray<ARadarActor*>& GetRadars() const { return Radars; }
+
+    // Ракета снята с полета: удалить ее треки во всех радарах
+    void ForgetMissile(AMissleActor* Missile);
+
+    // Подтвержденные слитые треки на момент Time в порядке регистрации радаров и их списков
+    // подтвержденных треков; неподтвержденные треки не просматриваются.
+    // Картина собирается один раз на момент: повторные запросы в том же шаге ее переиспользуют,
+    // снятие ракеты с полета и новые подтверждения сбрасывают ее.
+    const TArray<FRadarFusedTrack>& GetFusedTracks(float Time);
+
+    // Радар вывел события новых обнаружений: слитая картина могла получить новые цели
+    void NotifyDetections() { ++DetectionRevision; }
+    uint32 GetDetectionRevision() const { return DetectionRevision; }
+
+    // Шаг всех радаров в порядке регистрации, их сканы, подтверждение и очистка треков (вызывается часами боя)
+    void StepRadars(float DeltaTime);
+
+    static bool IsParallelScanEnabled();
+
+private:
+    UMissileSpatialSubsystem* SpatialIndex;
+
+    TArray<ARadarActor*> Radars;
+
+    // Часть скана: одна азимутальная корзина одного под-скана радара
+    struct FScanChunk
+    {
+        int32 ScanIndex;
+        int32 QueryIndex;
+        int32 Bucket;
+    };
+
+    // Рабочие буферы прохода (переиспользуются между кадрами)
+    TArray<ARadarActor*> PendingScans;
+    TArray<int32> ScanFirstChunks; // Части радара ScanIndex: [ScanFirstChunks[i], ScanFirstChunks[i + 1])
+    TArray<FScanChunk> ScanChunks;
+    TArray<TArray<AMissleActor*>> ChunkCandidates;
+    TArray<int32> SectorBuckets;
+
+    // Слитая картина и ее рабочие буферы
+    TArray<FRadarFusedTrack> FusedTracks;
+    TArray<MelSim::FTrackFusion> FusedEstimates;
+    TMap<AMissleActor*, int32> FusedIndexByMissile;
+    float FusedTime = -1.0f;
+    uint32 DetectionRevision = 0;
+
+    void ScanPendingRadars();
+    void RunParallelScan();
+
+    // Подтвердить ракеты, чьи треки получили обнаружения в этом шаге: сумма обнаружений ее треков
+    // во всех радарах достигла наименьшего порога ConfirmDetections этих радаров, или ракету уже
+    // подтвердил другой радар. Подтверждаются треки ракеты во всех радарах сразу, поэтому
+    // слитой картине достаточно списков подтвержденных.
+    void ConfirmTracks();
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sim/MelSimThreatHeap.h"
+#include "Sim/MelSimTrackFilter.h"
+#include "RadarTrackTable.generated.h"
+
+// Структура для хранения информации о ракете
+USTRUCT(BlueprintType)
+struct FMissileData
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite)
+    AActor* Missile;
+
+    UPROPERTY(BlueprintReadWrite)
+    FVector Position;
+
+    UPROPERTY(BlueprintReadWrite)
+    FVector Velocity;
+
+    UPROPERTY(BlueprintReadWrite)
+    FVector Acceleration;
+
+    UPROPERTY(BlueprintReadWrite)
+    FVector PredictedPosition;
+
+    UPROPERTY(BlueprintReadWrite)
+    float Distance;
+
+    UPROPERTY(BlueprintReadWrite)
+    float ThreatLevel;
+
+    UPROPERTY(BlueprintReadWrite)
+    float LastDetectionTime;
+
+    UPROPERTY(BlueprintReadWrite)
+    int32 DetectionCount;
+
+    UPROPERTY(BlueprintReadWrite)
+    bool bReportedTrajectory;
+
+    FMissileData()
+    {
+        Missile = nullptr;
+        Position = FVector::ZeroVector;
+        Velocity = FVector::ZeroVector;
+        Acceleration = FVector::ZeroVector;
+        PredictedPosition = FVector::ZeroVector;
+        Distance = 0.0f;
+        ThreatLevel = 0.0f;
+        LastDetectionTime = 0.0f;
+        DetectionCount = 0;
+        bReportedTrajectory = false;
+    }
+};
+
+// Стабильный идентификатор трека. Поколение отличает новый трек от удаленного,
+// занимавшего тот же слот, поэтому устаревший идентификатор ничего не находит.
+struct FRadarTrackId
+{
+    int32 Slot = INDEX_NONE;
+    uint32 Generation = 0;
+
+    bool IsValid() const { return Slot != INDEX_NONE; }
+    bool operator==(const FRadarTrackId& Other) const { return Slot == Other.Slot && Generation == Other.Generation; }
+    bool operator!=(const FRadarTrackId& Other) const { return !(*this == Other); }
+};
+
+class FRadarTrackTable;
+
+// Подтвержденные треки таблицы для range-for: без выделения памяти, в порядке подтверждения
+// (удаление переносит последний трек на место удаленного). Действителен, пока таблица не меняется.
+class MEL_API FRadarConfirmedTrackView
+{
+public:
+    class FIterator
+    {
+    public:
+        FIterator(const FRadarTrackTable& InTable, int32 InPosition) : Table(&InTable), Position(InPosition) {}
+
+        const FMissileData& operator*() const;
+        FIterator& operator++() { ++Position; return *this; }
+        bool operator!=(const FIterator& Other) const { return Position != Other.Position; }
+
+    private:
+        const FRadarTrackTable* Table;
+        int32 Position;
+    };
+
+    explicit FRadarConfirmedTrackView(const FRadarTrackTable& InTable) : Table(InTable) {}
+
+    int32 Num() const;
+    const FMissileData& operator[](int32 Position) const;
+
+    // Оценка фильтра трека на этом месте списка
+    const MelSim::FTrackEstimate& GetEstimate(int32 Position) const;
+
+    FIterator begin() const { return FIterator(Table, 0); }
+    FIterator end() const { return FIterator(Table, Num()); }
+
+private:
+    const FRadarTrackTable& Table;
+};
+
+// Таблица треков радара: плотный массив треков, слоты со стабильными идентификаторами,
+// хеш-индекс ракета -> слот и список свободных слотов. Поиск, добавление и удаление - O(1),
+// удаление переносит последний трек на место удаленного.
+// Слоты связаны в очередь по времени последнего обнаружения, поэтому устаревание
+// просматривает только истекшие треки, а не всю таблицу.
+// Угрозы треков упорядочены индексированной кучей: обновление одного трека - O(log N),
+// первые K по угрозе - O(K log K), без пересортировки таблицы на каждом скане.
+// Оценки фильтра лежат отдельным плотным массивом параллельно трекам и обновляются пакетно.
+// Подтвержденные треки ведутся отдельным списком слотов: трек входит в него при подтверждении
+// и выходит при удалении, поэтому обход подтвержденных не просматривает остальные треки.
+class MEL_API FRadarTrackTable
+{
+    friend class FRadarConfirmedTrackView;
+
+public:
+    int32 Num() const { return Tracks.Num(); }
+    void Reserve(int32 Number);
+    void Reset();
+
+    // Добавить трек ракеты, у которой еще нет трека
+    FRadarTrackId Add(const FMissileData& Track);
+    bool Remove(FRadarTrackId Id);
+
+    FRadarTrackId FindId(const AActor* Missile) const;
+    FMissileData* Find(FRadarTrackId Id);
+    const FMissileData* Find(FRadarTrackId Id) const;
+
+    // Плотный массив треков (порядок меняется при удалении)
+    const TArray<FMissileData>& GetTracks() const { return Tracks; }
+    FMissileData& GetTrack(int32 Index) { return Tracks[Index]; }
+    FRadarTrackId GetId(int32 Index) const;
+    int32 GetIndex(FRadarTrackId Id) const;
+
+    // Оценки фильтра по плотному индексу трека
+    MelSim::FTrackEstimate* GetEstimates() { return Estimates.GetData(); }
+    const MelSim::FTrackEstimate& GetEstimate(int32 Index) const { return Estimates[Index]; }
+
+    // Отметить обнаружение: трек переходит в конец очереди устаревания
+    void Touch(FRadarTrackId Id, float Time);
+
+    // Удалить треки, не обнаруживавшиеся с момента OlderThan. Возвращает число удаленных.
+    int32 RemoveExpired(float OlderThan);
+
+    // Трек набрал обнаружения для подтверждения (повторный вызов ничего не меняет)
+    void Confirm(FRadarTrackId Id);
+    bool IsConfirmed(FRadarTrackId Id) const;
+    FRadarConfirmedTrackView GetConfirmed() const { return FRadarConfirmedTrackView(*this); }
+
+    // Изменить угрозу трека с обновлением порядка
+    void SetThreatLevel(FRadarTrackId Id, float ThreatLevel);
+
+    // Обход треков по убыванию угрозы; Visitor возвращает true, чтобы остановить обход
+    void VisitByThreat(TFunctionRef<bool(FRadarTrackId, const FMissileData&)> Visitor) const;
+
+private:
+    struct FSlot
+    {
+        // Индекс в плотном массиве или INDEX_NONE для свободного слота
+        int32 Index = INDEX_NONE;
+        uint32 Generation = 0;
+
+        // Соседи в очереди устаревания (от давно обнаруженных к недавним)
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+
+        // Место в списке подтвержденных или INDEX_NONE
+        int32 ConfirmedIndex = INDEX_NONE;
+    };
+
+    TArray<FMissileData> Tracks;
+    TArray<MelSim::FTrackEstimate> Estimates;
+    TArray<int32> TrackSlots;
+    TArray<FSlot> Slots;
+    TArray<int32> FreeSlots;
+    TArray<int32> ConfirmedSlots;
+    TMap<const AActor*, int32> SlotByMissile;
+
+    int32 OldestSlot = INDEX_NONE;
+    int32 NewestSlot = INDEX_NONE;
+
+    // Порядок слотов по угрозе
+    MelSim::FThreatHeap ThreatRanking;
+
+    void LinkNewest(int32 Slot);
+    void Unlink(int32 Slot);
+    void RemoveSlot(int32 Slot);
+};
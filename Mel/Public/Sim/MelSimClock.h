@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MelSim
+{
+    // Часы боя с фиксированным шагом. Время кадра копится в аккумуляторе и расходуется целыми шагами,
+    // поэтому последовательность шагов (и результат боя) не зависит от частоты кадров.
+    struct FFixedStepClock
+    {
+        float StepTime = 1.0f / 60.0f;
+
+        // Время сверх этого числа шагов за кадр отбрасывается (бой замедляется, но не расходится)
+        int32_t MaxStepsPerFrame = 8;
+
+        double Accumulator = 0.0;
+        int64_t StepIndex = 0;
+
+        // Время начала текущего шага: зависит только от номера шага
+        float GetTime() const { return static_cast<float>(static_cast<double>(StepIndex) * StepTime); }
+    };
+
+    // Добавить время кадра и вернуть число шагов, которые нужно выполнить.
+    // StepIndex увеличивает вызывающий после каждого шага.
+    int32_t AdvanceClock(FFixedStepClock& Clock, float FrameTime);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Sim/MelSimMissileBatch.h"
+#include "Sim/MelSimRadar.h"
+#include "Sim/MelSimProjectile.h"
+#include "Sim/MelSimReplay.h"
+#include "Sim/MelSimFireControl.h"
+#include "Sim/MelSimIntercept.h"
+#include <vector>
+
+namespace MelSim
+{
+    struct FEngagementStats
+    {
+        int32_t MissilesLaunched = 0;
+        int32_t MissilesIntercepted = 0;
+        int32_t MissilesImpacted = 0;
+        int32_t ProjectilesFired = 0;
+        int32_t Steps = 0;
+    };
+
+    // Безголовая симуляция боя: ракеты, радары, батареи ПВО и снаряды в плоских массивах.
+    // Логика шага та же, что у акторов Mel; мир заменен плоской землей (Z = 0).
+    // Подтверждение по сумме обнаружений всех радаров и цели батарей (слитые подтвержденные треки) -
+    // как у URadarNetworkSubsystem::ConfirmTracks и GetFusedTracks.
+    class FEngagement
+    {
+    public:
+        // Снаряд без попадания удаляется по истечении этого времени полета
+        float MaxProjectileFlightTime = 30.0f;
+
+        // Период распределения целей между готовыми батареями и порог прироста вероятности поражения
+        float FireControlInterval = 0.1f;
+        float MinKillGain = 0.1f;
+
+        int32_t AddMissile(const FVec3& LaunchPoint, const FVec3& TargetPoint, const FMissileParams& Params = FMissileParams());
+        int32_t AddRadar(const FVec3& Location, const FRadarParams& Params = FRadarParams());
+        int32_t AddBattery(const FVec3& Location, int32_t RadarIndex, const FBatteryParams& Params = FBatteryParams());
+
+        // Писать размещение, пуски и выстрелы в журнал (nullptr - не писать)
+        void SetRecorder(FReplayLog* InRecorder) { Recorder = InRecorder; }
+
+        // Шаг фиксированной длины: ракеты, радары, батареи, снаряды
+        void Step(float Dt);
+
+        // Шагать, пока есть живые ракеты, но не дольше MaxTime
+        void Run(float Dt, float MaxTime);
+
+        bool HasLiveMissiles() const { return Missiles.Num() > 0; }
+        float GetTime() const { return Time; }
+        const FEngagementStats& GetStats() const { return Stats; }
+
+        const FMissileBatch& GetMissiles() const { return Missiles; }
+        const std::vector<FProjectileState>& GetProjectiles() const { return Projectiles; }
+        const std::vector<FRadarState>& GetRadars() const { return Radars; }
+        const std::vector<FBatteryState>& GetBatteries() const { return Batteries; }
+
+    private:
+        FMissileBatch Missiles;
+        std::vector<FRadarState> Radars;
+        std::vector<FBatteryState> Batteries;
+        std::vector<FBatteryParams> BatteryParams;
+        std::vector<FProjectileState> Projectiles;
+
+        float Time = 0.0f;
+        FEngagementStats Stats;
+
+        // Ракеты, чьи неподтвержденные треки получили засчитанное обнаружение в этом шаге
+        std::vector<int32_t> PendingConfirmations;
+
+        // Слитая цель: подтвержденные треки одной ракеты по всем радарам
+        struct FFusedTarget
+        {
+            int32_t MissileId = -1;
+            float ThreatLevel = 0.0f; // Наибольшая угроза по радарам
+            FTrackFusion Fusion;
+            FVec3 Position;           // Оценка на момент распределения
+            FVec3 Velocity;
+        };
+
+        // Распределение целей и его рабочие буферы
+        float TimeSinceAssignment = 0.0f;
+        FWeaponTargetAssignment Assignment;
+        std::vector<FFusedTarget> Targets;
+        std::vector<int32_t> TargetByMissileIndex;
+        std::vector<float> TargetSurvivals;
+        std::vector<int32_t> ShooterBatteries;
+        std::vector<FInterceptSolution> OptionIntercepts;
+        FReplayLog* Recorder = nullptr;
+
+        void Record(EReplayEventType Type, const FVec3& Position, const FVec3& Target);
+
+        void StepMissiles(float Dt);
+        void StepRadars(float Dt);
+        void ConfirmTracks();
+        void StepBatteries(float Dt);
+        void AssignTargets();
+        void StepProjectiles(float Dt);
+        void KillMissile(int32_t MissileId);
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace MelSim
+{
+    // Вероятность поражения одним снарядом: KillProbability при встрече сразу после пуска,
+    // линейно падает до нуля к MaxInterceptTime (цель успевает сманеврировать, снаряд - рассеяться)
+    float EstimateKillProbability(float KillProbability, float InterceptTime, float MaxInterceptTime);
+
+    // Распределение целей между готовыми к выстрелу батареями (weapon-target assignment).
+    // Жадный аукцион: на каждом шаге выбирается пара батарея-цель с наибольшим приростом
+    // ожидаемого поражения Value * Survival * Pk, после чего выживаемость цели умножается на (1 - Pk).
+    // Поэтому вторая батарея стреляет по уже обстрелянной цели, только если прочие цели ценнее.
+    // Каждая батарея получает не больше одной цели. Результат детерминирован: при равенстве
+    // выигрывает вариант, добавленный раньше.
+    class FWeaponTargetAssignment
+    {
+    public:
+        struct FOption
+        {
+            int32_t Shooter = -1;
+            int32_t Target = -1;
+            float KillProbability = 0.0f;
+        };
+
+        void Reset();
+
+        // Value - ценность цели (угроза), Survival - вероятность пережить снаряды, уже летящие в нее
+        int32_t AddTarget(float Value, float Survival = 1.0f);
+        int32_t AddShooter();
+
+        // Батарея может поразить цель с вероятностью KillProbability; возвращает номер варианта
+        int32_t AddOption(int32_t Shooter, int32_t Target, float KillProbability);
+
+        // Назначения, не увеличивающие вероятность поражения хотя бы на MinKillGain, не делаются
+        void Solve(float MinKillGain = 0.0f);
+
+        // Вариант, назначенный батарее (или -1)
+        int32_t GetAssignedOption(int32_t Shooter) const { return AssignedOptions[Shooter]; }
+        const FOption& GetOption(int32_t Option) const { return Options[Option]; }
+
+        int32_t NumShooters() const { return static_cast<int32_t>(AssignedOptions.size()); }
+        int32_t NumTargets() const { return static_cast<int32_t>(TargetValues.size()); }
+        int32_t NumOptions() const { return static_cast<int32_t>(Options.size()); }
+
+        // Выживаемость цели с учетом назначенных выстрелов
+        float GetSurvival(int32_t Target) const { return TargetSurvivals[Target]; }
+
+    private:
+        std::vector<float> TargetValues;
+        std::vector<float> TargetSurvivals;
+        std::vector<FOption> Options;
+        std::vector<int32_t> AssignedOptions;
+    };
+}
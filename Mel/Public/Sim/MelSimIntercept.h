@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Sim/MelSimMissile.h"
+
+namespace MelSim
+{
+    // Решение задачи встречи снаряда постоянной скорости с целью
+    struct FInterceptSolution
+    {
+        FVec3 AimPoint;     // Точка встречи
+        FVec3 Direction;    // Единичное направление пуска
+        float Time = 0.0f;  // Время полета до встречи
+    };
+
+    // Цель с постоянной скоростью: наименьший положительный корень |D + V t| = Speed t, D = цель - стрелок.
+    // false, если снаряд не догоняет цель.
+    bool SolveIntercept(const FVec3& Shooter, float Speed, const FVec3& TargetPosition, const FVec3& TargetVelocity,
+                        FInterceptSolution& OutSolution);
+
+    // Ракета на известном профиле фаз: траектория прогнозируется StepMissile с шагом PredictionStep,
+    // на каждом отрезке ракета считается равномерной и решается то же уравнение.
+    // false, если встречи нет до MaxTime или до падения ракеты.
+    bool SolveMissileIntercept(const FVec3& Shooter, float Speed, const FMissileState& Missile, const FMissileParams& Params,
+                               float MaxTime, FInterceptSolution& OutSolution, float PredictionStep = 0.1f);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// Ядро симуляции не зависит от движка: только стандартная библиотека C++.
+// Вектор повторяет семантику FVector в той мере, в которой она нужна логике ракет, радара и ПВО.
+
+#include <cmath>
+#include <cstdint>
+
+namespace MelSim
+{
+    constexpr float SmallNumber = 1.e-8f;
+    constexpr float KindaSmallNumber = 1.e-4f;
+    constexpr float Pi = 3.1415926535897932f;
+
+    inline float DegreesToRadians(float Degrees) { return Degrees * (Pi / 180.0f); }
+    inline float RadiansToDegrees(float Radians) { return Radians * (180.0f / Pi); }
+    inline float Clamp(float Value, float Min, float Max) { return Value < Min ? Min : (Value > Max ? Max : Value); }
+
+    // Аналог FMath::SmoothStep(0, 1, X)
+    inline float SmoothStep01(float X)
+    {
+        if (X <= 0.0f) return 0.0f;
+        if (X >= 1.0f) return 1.0f;
+        return X * X * (3.0f - 2.0f * X);
+    }
+
+    struct FVec3
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+
+        FVec3() = default;
+        constexpr FVec3(float InX, float InY, float InZ) : X(InX), Y(InY), Z(InZ) {}
+
+        FVec3 operator+(const FVec3& V) const { return FVec3(X + V.X, Y + V.Y, Z + V.Z); }
+        FVec3 operator-(const FVec3& V) const { return FVec3(X - V.X, Y - V.Y, Z - V.Z); }
+        FVec3 operator*(float Scale) const { return FVec3(X * Scale, Y * Scale, Z * Scale); }
+        FVec3& operator+=(const FVec3& V) { X += V.X; Y += V.Y; Z += V.Z; return *this; }
+        FVec3& operator-=(const FVec3& V) { X -= V.X; Y -= V.Y; Z -= V.Z; return *this; }
+
+        float SizeSquared() const { return X * X + Y * Y + Z * Z; }
+        float Size() const { return std::sqrt(SizeSquared()); }
+        float Size2D() const { return std::sqrt(X * X + Y * Y); }
+
+        // Как FVector::GetSafeNormal: нулевой вектор для слишком коротких векторов
+        FVec3 GetSafeNormal() const
+        {
+            const float SquareSum = SizeSquared();
+            if (SquareSum <= SmallNumber)
+            {
+                return FVec3();
+            }
+            const float Scale = 1.0f / std::sqrt(SquareSum);
+            return FVec3(X * Scale, Y * Scale, Z * Scale);
+        }
+
+        static float Dot(const FVec3& A, const FVec3& B) { return A.X * B.X + A.Y * B.Y + A.Z * B.Z; }
+        static float DistSquared(const FVec3& A, const FVec3& B) { return (A - B).SizeSquared(); }
+        static float Dist(const FVec3& A, const FVec3& B) { return (A - B).Size(); }
+        static FVec3 Lerp(const FVec3& A, const FVec3& B, float Alpha) { return A + (B - A) * Alpha; }
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Sim/MelSimMath.h"
+
+namespace MelSim
+{
+    // Порядок совпадает с EMisslePhase
+    enum class EMissilePhase : uint8_t
+    {
+        Ascending,    // Вертикальный подъем
+        Transition,   // Плавный переход к цели
+        Horizontal,   // Горизонтальный полет на заданной высоте
+        Descent       // Плавное снижение к цели
+    };
+
+    // Параметры полета (значения по умолчанию как у AMissleActor)
+    struct FMissileParams
+    {
+        float TargetHeight = 20000.0f;
+        float HorizontalHeight = 17000.0f;
+        float HorizontalDistance = 5000.0f;
+        float Speed = 1500.0f;
+        float TransitionTime = 1.0f;
+
+        // Расстояние, на котором горизонтальный участок считается пройденным
+        float HorizontalArrivalTolerance = 100.0f;
+
+        // Расстояние до точки цели, на котором ракета считается долетевшей
+        float ImpactTolerance = 100.0f;
+    };
+
+    struct FMissileState
+    {
+        FVec3 Position;
+        FVec3 Velocity;
+        FVec3 TargetPoint;
+        FVec3 TargetDirection;
+        FVec3 HorizontalStartPoint; // Точка начала горизонтального полета
+        FVec3 HorizontalEndPoint;   // Точка окончания горизонтального полета
+        float TransitionElapsed = 0.0f;
+        EMissilePhase Phase = EMissilePhase::Ascending;
+    };
+
+    // Ракета на старте: направлена строго вверх
+    FMissileState MakeMissile(const FVec3& LaunchPoint, const FVec3& TargetPoint, const FMissileParams& Params);
+
+    // Один шаг автомата фаз и интегрирование позиции. Возвращает true, если фаза сменилась.
+    bool StepMissile(FMissileState& State, const FMissileParams& Params, float Dt);
+
+    // Ракета на участке снижения достигла точки цели или земли
+    bool HasReachedTarget(const FMissileState& State, const FMissileParams& Params);
+}
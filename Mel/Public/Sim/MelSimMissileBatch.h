@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Sim/MelSimMissile.h"
+#include <vector>
+
+namespace MelSim
+{
+    // Пакет ракет в виде структуры массивов (SoA).
+    // Step обновляет все ракеты одним векторизованным проходом (SSE, по 4 ракеты),
+    // результат побитово совпадает со StepMissile для каждой ракеты.
+    // Ракеты адресуются стабильными идентификаторами, плотные индексы меняются при удалении.
+    class FMissileBatch
+    {
+    public:
+        int32_t Add(const FMissileState& State, const FMissileParams& Params);
+        void Remove(int32_t Id);
+
+        bool Contains(int32_t Id) const;
+        int32_t Num() const { return static_cast<int32_t>(IndexToId.size()); }
+
+        // Плотный индекс ракеты (или -1) и обратное отображение
+        int32_t GetIndex(int32_t Id) const { return Contains(Id) ? IdToIndex[Id] : -1; }
+        int32_t GetId(int32_t Index) const { return IndexToId[Index]; }
+
+        void Step(float Dt);
+
+        FVec3 GetPosition(int32_t Index) const { return FVec3(PosX[Index], PosY[Index], PosZ[Index]); }
+        FVec3 GetVelocity(int32_t Index) const { return FVec3(VelX[Index], VelY[Index], VelZ[Index]); }
+        EMissilePhase GetPhase(int32_t Index) const { return static_cast<EMissilePhase>(Phase[Index]); }
+        void SetPosition(int32_t Index, const FVec3& Position);
+
+        FMissileState GetState(int32_t Index) const;
+        FMissileParams GetParams(int32_t Index) const;
+        bool HasReachedTarget(int32_t Index) const;
+
+    private:
+        // Кинематика
+        std::vector<float> PosX, PosY, PosZ;
+        std::vector<float> VelX, VelY, VelZ;
+
+        // Точки маршрута
+        std::vector<float> TargetX, TargetY, TargetZ;
+        std::vector<float> DirX, DirY, DirZ;
+        std::vector<float> HorizontalStartX, HorizontalStartY, HorizontalStartZ;
+        std::vector<float> HorizontalEndX, HorizontalEndY, HorizontalEndZ;
+        std::vector<float> TransitionElapsed;
+        std::vector<int32_t> Phase;
+
+        // Параметры полета
+        std::vector<float> Speed;
+        std::vector<float> TargetHeight;
+        std::vector<float> HorizontalHeight;
+        std::vector<float> HorizontalDistance;
+        std::vector<float> TransitionTime;
+        std::vector<float> ArrivalTolerance;
+        std::vector<float> ImpactTolerance;
+
+        // Стабильные идентификаторы
+        std::vector<int32_t> IndexToId;
+        std::vector<int32_t> IdToIndex;
+        std::vector<int32_t> FreeIds;
+
+        void SetState(int32_t Index, const FMissileState& State);
+        void StepScalar(int32_t Index, float Dt);
+        void StepSimd4(int32_t Index, float Dt);
+        void ApplyPhaseChange(int32_t Index);
+    };
+}
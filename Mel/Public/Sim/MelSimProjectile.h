@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Sim/MelSimMath.h"
+
+namespace MelSim
+{
+    // Дистанция прямого попадания в цель (2 метра)
+    constexpr float ProjectileHitRadius = 200.0f;
+
+    // Дистанция подрыва по близости от любой ракеты (3 метра)
+    constexpr float ProjectileProximityRadius = 300.0f;
+
+    struct FProjectileState
+    {
+        FVec3 Position;
+        FVec3 PreviousPosition; // Положение в начале последнего шага
+        FVec3 Forward;
+        float Speed = 3000.0f;
+        float ForwardDistance = 2000.0f; // Участок прямого полета до включения наведения
+        float TravelledDistance = 0.0f;
+        float FlightTime = 0.0f;
+        int32_t TargetId = -1;
+        float KillProbability = 0.0f; // Оценка при пуске: учитывается при распределении целей, пока снаряд летит
+        bool bIsHoming = false;
+        bool bAlive = true;
+    };
+
+    enum class EProjectileResult : uint8_t
+    {
+        None,
+        HitTarget
+    };
+
+    FProjectileState MakeProjectile(const FVec3& Origin, const FVec3& Forward, int32_t TargetId,
+                                    float ForwardDistance, float Speed);
+
+    // Шаг снаряда: прямой полет, затем наведение с упреждением.
+    // TargetPosition/TargetVelocity равны nullptr, если цели больше нет.
+    // Попадание в цель проверяется по наименьшему сближению за весь шаг, а не в одной точке.
+    EProjectileResult StepProjectile(FProjectileState& State, const FVec3* TargetPosition,
+                                     const FVec3* TargetVelocity, float Dt);
+
+    // Наименьшее расстояние (в квадрате) между точками, равномерно движущимися за шаг из A0 в A1
+    // и из B0 в B1. OutAlpha - доля шага в момент наибольшего сближения.
+    float SweptClosestDistSquared(const FVec3& A0, const FVec3& A1, const FVec3& B0, const FVec3& B1, float& OutAlpha);
+
+    // Сблизился ли снаряд за последний шаг Dt с ракетой, пришедшей в MissilePosition
+    // со скоростью MissileVelocity, ближе чем на Radius. Шаг ракеты не теряется при низкой частоте шагов.
+    bool SweptProximity(const FProjectileState& State, const FVec3& MissilePosition, const FVec3& MissileVelocity,
+                        float Dt, float Radius);
+
+    // Параметры батареи ПВО (значения по умолчанию как у AAAActor)
+    struct FBatteryParams
+    {
+        float FireInterval = 2.0f;
+        float ProjectileSpeed = 3000.0f;
+        float InitialForwardDistance = 2000.0f;
+        float DetectionRadius = 20000.0f;
+
+        // Цель не обстреливается, если встреча позже этого времени (время жизни снаряда)
+        float MaxInterceptTime = 30.0f;
+
+        // Вероятность поражения при встрече сразу после пуска (см. EstimateKillProbability)
+        float KillProbability = 0.8f;
+    };
+
+    struct FBatteryState
+    {
+        FVec3 Position;
+        float TimeSinceLastFire = 0.0f;
+        int32_t RadarIndex = 0; // Радар батареи; цели распределяются по подтвержденным трекам всех радаров
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Sim/MelSimProjectile.h"
+#include <vector>
+
+namespace MelSim
+{
+    // Пакет снарядов ПВО в непрерывных массивах. Цели задаются на шаг заранее (SetTarget),
+    // после чего StepRange обновляет непересекающиеся диапазоны независимо - их можно
+    // раздать рабочим потокам. Результат побитово совпадает со StepProjectile для каждого снаряда.
+    // Снаряды адресуются стабильными идентификаторами, плотные индексы меняются при удалении.
+    class FProjectileBatch
+    {
+    public:
+        int32_t Add(const FProjectileState& State);
+        void Remove(int32_t Id);
+
+        bool Contains(int32_t Id) const;
+        int32_t Num() const { return static_cast<int32_t>(IndexToId.size()); }
+
+        // Плотный индекс снаряда (или -1) и обратное отображение
+        int32_t GetIndex(int32_t Id) const { return Contains(Id) ? IdToIndex[Id] : -1; }
+        int32_t GetId(int32_t Index) const { return IndexToId[Index]; }
+
+        // Цель на следующий шаг; без вызова SetTarget снаряд летит прямо
+        void SetTarget(int32_t Index, const FVec3& Position, const FVec3& Velocity);
+        void ClearTarget(int32_t Index) { HasTarget[Index] = 0; }
+
+        // Шаг снарядов [Begin, End) и всего пакета
+        void StepRange(int32_t Begin, int32_t End, float Dt);
+        void Step(float Dt) { StepRange(0, Num(), Dt); }
+
+        const FProjectileState& GetState(int32_t Index) const { return States[Index]; }
+        EProjectileResult GetResult(int32_t Index) const { return static_cast<EProjectileResult>(Results[Index]); }
+
+    private:
+        std::vector<FProjectileState> States;
+
+        // Цели текущего шага
+        std::vector<FVec3> TargetPositions;
+        std::vector<FVec3> TargetVelocities;
+        std::vector<uint8_t> HasTarget;
+
+        // Результат последнего шага (EProjectileResult)
+        std::vector<uint8_t> Results;
+
+        // Стабильные идентификаторы
+        std::vector<int32_t> IndexToId;
+        std::vector<int32_t> IdToIndex;
+        std::vector<int32_t> FreeIds;
+    };
+}
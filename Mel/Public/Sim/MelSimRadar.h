@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Sim/MelSimMath.h"
+#include "Sim/MelSimTrackFilter.h"
+#include <vector>
+
+namespace MelSim
+{
+    // Параметры радара (значения по умолчанию как у ARadarActor)
+    struct FRadarParams
+    {
+        float ScanRadius = 25000.0f;
+        float ScanSpeed = 300.0f;
+        float ScanInterval = 0.05f;
+        float ScanSectorWidth = 20.0f;
+        float MinDetectionHeight = 1000.0f;
+        float MaxDetectionHeight = 25000.0f;
+        float PredictionTime = 2.0f;
+        float ThreatDistanceWeight = 0.4f;
+        float ThreatSpeedWeight = 0.3f;
+        float ThreatHeightWeight = 0.3f;
+
+        // Трек удаляется, если цель не обнаруживалась дольше этого времени
+        float TrackTimeout = 5.0f;
+
+        // Число обнаружений, после которого цель доступна ПВО
+        int32_t ConfirmDetections = 3;
+
+        // Число обнаружений, после которого трек полностью отчитан (дальше только сопровождение)
+        int32_t MaxDetections = 4;
+
+        // Фильтр оценки скорости и ускорения по обнаружениям положения
+        FTrackFilterParams Filter;
+
+        // Уровень детализации треков: трек дальше FullDetailRange с угрозой ниже FullDetailThreat
+        // обновляется не чаще раза в FarTrackUpdateInterval, без прогноза траектории, и не отчитывается
+        // дальше подтверждения. Ближе порога или с угрозой выше трек сразу получает полную детализацию.
+        // FullDetailRange <= 0 отключает уровни детализации.
+        float FullDetailRange = 15000.0f;
+        float FullDetailThreat = 0.5f;
+        float FarTrackUpdateInterval = 0.25f;
+
+        // Скан по всему сектору, пройденному лучом, с фиксированным шагом ScanInterval
+        bool bSweptScan = true;
+    };
+
+    // Часы сканирования с фиксированным шагом. Угол луча на каждом скане зависит только от номера скана,
+    // поэтому набор проверенных секторов не зависит от частоты кадров.
+    struct FSweepClock
+    {
+        float SweepAngle = 0.0f; // Угол луча на последнем скане
+        float TimeSinceLastScan = 0.0f;
+        bool bStarted = false;   // Первый под-скан покрывает и луч в начальном положении
+    };
+
+    // Под-скан: сектор, который луч покрыл за шаг впервые. Луч шириной W, прошедший от From до To,
+    // покрывает [From - W/2, To + W/2], из них [From - W/2, From + W/2] покрыл предыдущий под-скан,
+    // поэтому под-сканы кладутся встык шириной в пройденный угол и цель попадает в луч раз за оборот.
+    struct FSweepInterval
+    {
+        float CenterAngle = 0.0f;
+        float Width = 0.0f;
+
+        // Насколько под-скан опоздал относительно своего момента по часам: положения целей
+        // отматываются на это время назад, чтобы результат не зависел от нарезки кадров
+        float Age = 0.0f;
+    };
+
+    // Максимум под-сканов за один шаг симуляции; более старые шаги сливаются в первый под-скан
+    constexpr int32_t MaxSubScansPerStep = 8;
+
+    // Трек цели: аналог FMissileData без ссылки на актор
+    struct FTrack
+    {
+        int32_t MissileId = -1;
+        FVec3 Position;
+        FVec3 Velocity;
+        FVec3 Acceleration;
+        FVec3 PredictedPosition;
+        float Distance = 0.0f;
+        float ThreatLevel = 0.0f;
+        float LastDetectionTime = 0.0f;
+        int32_t DetectionCount = 0;
+        bool bReportedTrajectory = false;
+        bool bConfirmed = false; // Ракету подтвердила сеть по сумме обнаружений всех радаров
+        FTrackEstimate Estimate;
+    };
+
+    struct FRadarState
+    {
+        FVec3 Position;
+        FRadarParams Params;
+        float ScanAngle = 0.0f;
+        float TimeSinceLastScan = 0.0f;
+        FSweepClock Sweep;
+        std::vector<FTrack> Tracks;
+
+        // Индекс трека по идентификатору ракеты (-1 - трека нет): поиск трека при обнаружении за O(1)
+        std::vector<int32_t> TrackByMissileId;
+    };
+
+    // Повернуть луч и вернуть угол в диапазоне [0, 360)
+    float AdvanceScanAngle(float ScanAngle, float ScanSpeed, float Dt);
+
+    bool IsInHeightRange(const FRadarParams& Params, const FVec3& Location);
+    bool IsInScanSector(const FRadarParams& Params, const FVec3& RadarLocation, float ScanAngle, const FVec3& Location);
+
+    // Продвинуть часы на Dt и записать накопившиеся под-сканы (не больше MaxSubScansPerStep).
+    // Возвращает число под-сканов.
+    int32_t AdvanceSweep(const FRadarParams& Params, FSweepClock& Clock, float Dt, FSweepInterval* OutIntervals);
+
+    // Угол луча между сканами (для отрисовки)
+    float GetBeamAngle(const FRadarParams& Params, const FSweepClock& Clock);
+
+    // Проверка попадания в сектор под-скана; ось и косинус считаются один раз на под-скан
+    struct FSweptSectorTest
+    {
+        FVec3 Origin;
+        float AxisX;
+        float AxisY;
+        float CosHalfWidth;
+        float RadiusSquared;
+
+        FSweptSectorTest(const FRadarParams& Params, const FVec3& RadarLocation, const FSweepInterval& Interval);
+        bool Contains(const FVec3& Location) const;
+    };
+
+    // Линейный прогноз положения по оцененной скорости; для снижающейся цели - точка падения.
+    // Ускорение в прогноз не входит: на ломаном профиле ракеты оно добавляет ошибку.
+    void PredictTrajectory(const FRadarParams& Params, const FVec3& Position, const FVec3& Velocity, FVec3& InOutPredicted);
+
+    float ComputeThreatLevel(const FRadarParams& Params, const FVec3& RadarLocation,
+                             const FVec3& Position, const FVec3& Velocity, float Distance);
+
+    // Трек дальней зоны: далеко и неопасен (см. FRadarParams::FullDetailRange)
+    bool IsFarFieldTrack(const FRadarParams& Params, float Distance, float ThreatLevel);
+
+    // Обнаружение трека дальней зоны раньше FarTrackUpdateInterval после прошлого обновления
+    // только продлевает трек: фильтр, счетчик и угроза не меняются
+    bool ShouldSkipFarFieldUpdate(const FRadarParams& Params, const FTrackEstimate& Estimate, float Distance, float ThreatLevel, float Now);
+
+    // Счет обнаружений трека (общий для радаров Mel и безголовой симуляции): после MaxDetections
+    // трек отчитан полностью и счет останавливается, трек дальней зоны считается только до
+    // подтверждения - отчет о траектории ждет полной детализации. Возвращает true, если обнаружение засчитано.
+    bool CountDetection(const FRadarParams& Params, bool bFarField, int32_t& DetectionCount, bool& bReportedTrajectory);
+
+    // Обновить трек по обнаружению положения: фильтр, прогноз, угроза (с учетом уровня детализации).
+    // Возвращает true, если обнаружение засчитано (трек еще не отчитан полностью).
+    bool ApplyDetection(const FRadarParams& Params, const FVec3& RadarLocation, FTrack& Track, const FVec3& Position, float Now);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Sim/MelSimMath.h"
+#include <cstddef>
+#include <vector>
+
+namespace MelSim
+{
+    class FEngagement;
+    struct FEngagementStats;
+
+    enum class EReplayEventType : uint8_t
+    {
+        Radar,   // Position - радар
+        Battery, // Position - батарея ПВО
+        Missile, // Position - точка пуска, Target - точка цели
+        Fire     // Position - батарея, Target - положение цели в момент выстрела
+    };
+
+    // Событие боя на шаге фиксированных часов
+    struct FReplayEvent
+    {
+        int32_t Step = 0;
+        EReplayEventType Type = EReplayEventType::Missile;
+        FVec3 Position;
+        FVec3 Target;
+
+        // Побитовое совпадение координат: журнал сравнивается для проверки детерминизма
+        bool operator==(const FReplayEvent& Other) const;
+        bool operator!=(const FReplayEvent& Other) const { return !(*this == Other); }
+    };
+
+    // Журнал входов боя: зерно генератора, длина шага и события по шагам.
+    // Размещение, пуски и зерно достаточно для повтора - решения о стрельбе пишутся для сверки.
+    class FReplayLog
+    {
+    public:
+        uint32_t Seed = 0;
+        float StepTime = 1.0f / 60.0f;
+
+        void Reset(uint32_t InSeed, float InStepTime);
+        void Add(const FReplayEvent& Event) { Events.push_back(Event); }
+
+        const std::vector<FReplayEvent>& GetEvents() const { return Events; }
+        int32_t Num() const { return static_cast<int32_t>(Events.size()); }
+
+        // Компактная двоичная запись: заголовок и события фиксированного размера (29 байт)
+        void Save(std::vector<uint8_t>& OutBytes) const;
+        bool Load(const uint8_t* Bytes, size_t Size);
+
+        // Индекс первого расхождения с другим журналом или -1, если журналы совпадают
+        int32_t FindDivergence(const FReplayLog& Other) const;
+
+    private:
+        std::vector<FReplayEvent> Events;
+    };
+
+    // Повторить бой из журнала на безголовой симуляции: радары, батареи и ракеты добавляются
+    // на записанных шагах. Батареи работают от первого радара, как AAAActor.
+    FEngagementStats ReplayEngagement(const FReplayLog& Log, FEngagement& Engagement, float MaxTime);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace MelSim
+{
+    // Индексированная двоичная куча по убыванию угрозы.
+    // Ключи - небольшие неотрицательные целые (слоты треков), у каждого ключа известна позиция в куче,
+    // поэтому обновление и удаление одного трека стоят O(log N), а не полной пересортировки.
+    class FThreatHeap
+    {
+    public:
+        int32_t Num() const { return static_cast<int32_t>(Keys.size()); }
+        bool IsEmpty() const { return Keys.empty(); }
+        bool Contains(int32_t Key) const;
+        void Reset();
+
+        // Добавить ключ или обновить его угрозу
+        void Set(int32_t Key, float Threat);
+        void Remove(int32_t Key);
+
+        // Ключ с наибольшей угрозой (или -1)
+        int32_t Top() const { return Keys.empty() ? -1 : Keys[0]; }
+        float GetThreat(int32_t Key) const { return Threats[Positions[Key]]; }
+
+        // Обход ключей по убыванию угрозы без изменения кучи.
+        // Visitor(Key) возвращает true, чтобы остановить обход; K посещенных ключей стоят O(K log K).
+        // Граница обхода лежит в буфере вызывающего (Frontier), поэтому обходы независимы
+        // и допускают параллельное чтение и вложенный обход из Visitor.
+        template <typename VisitorType>
+        void VisitDescending(std::vector<int32_t>& Frontier, VisitorType&& Visitor) const;
+
+        // То же с локальным буфером
+        template <typename VisitorType>
+        void VisitDescending(VisitorType&& Visitor) const
+        {
+            std::vector<int32_t> Frontier;
+            VisitDescending(Frontier, std::forward<VisitorType>(Visitor));
+        }
+
+        // Первые Count ключей по убыванию угрозы
+        void GetTop(int32_t Count, std::vector<int32_t>& OutKeys) const;
+
+    private:
+        std::vector<int32_t> Keys;
+        std::vector<float> Threats;
+
+        // Позиция ключа в куче или -1
+        std::vector<int32_t> Positions;
+
+        bool IsAbove(int32_t A, int32_t B) const { return Threats[A] > Threats[B]; }
+        void SwapNodes(int32_t A, int32_t B);
+        void SiftUp(int32_t Position);
+        void SiftDown(int32_t Position);
+        // Граница обхода VisitDescending - позиции узлов кучи, упорядоченные по угрозе
+        void PushFrontier(std::vector<int32_t>& Frontier, int32_t Position) const;
+        int32_t PopFrontier(std::vector<int32_t>& Frontier) const;
+    };
+
+    template <typename VisitorType>
+    void FThreatHeap::VisitDescending(std::vector<int32_t>& Frontier, VisitorType&& Visitor) const
+    {
+        Frontier.clear();
+        if (Keys.empty())
+            return;
+
+        // Потомки узла не опаснее его самого, поэтому следующий по угрозе ключ
+        // всегда лежит на границе уже посещенного поддерева
+        PushFrontier(Frontier, 0);
+        while (!Frontier.empty())
+        {
+            const int32_t Position = PopFrontier(Frontier);
+            if (Visitor(Keys[Position]))
+                break;
+
+            const int32_t Left = Position * 2 + 1;
+            if (Left < Num())
+                PushFrontier(Frontier, Left);
+            if (Left + 1 < Num())
+                PushFrontier(Frontier, Left + 1);
+        }
+        Frontier.clear();
+    }
+}
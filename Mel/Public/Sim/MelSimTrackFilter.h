@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Sim/MelSimMath.h"
+
+namespace MelSim
+{
+    // Коэффициенты фильтра альфа-бета-гамма. По умолчанию - критическое затухание с θ = 0.3
+    // (см. MakeTrackFilterParams)
+    struct FTrackFilterParams
+    {
+        float Alpha = 0.973f;
+        float Beta = 0.9555f;
+        float Gamma = 0.1715f;
+
+        // Обнаружения чаще этого интервала (соседние под-сканы одного шага) не обновляют скорость
+        float MinInterval = 0.001f;
+    };
+
+    // Критически затухающий фильтр с коэффициентом забывания Discount (θ): 0 - оценка
+    // проходит через последние обнаружения, ближе к 1 - сильнее сглаживание шума и больше запаздывание.
+    // Alpha = 1 - θ^3, Beta = 1.5 (1 - θ)^2 (1 + θ), Gamma = 0.5 (1 - θ)^3
+    FTrackFilterParams MakeTrackFilterParams(float Discount);
+
+    // Оценка состояния цели по обнаружениям только положения
+    struct FTrackEstimate
+    {
+        FVec3 Position;
+        FVec3 Velocity;
+        FVec3 Acceleration;
+        float Time = 0.0f;        // Время последнего обнаружения
+        int32_t NumUpdates = 0;   // Первое обнаружение задает положение, второе - скорость
+    };
+
+    // Обнаружение для пакетного обновления: Index - индекс оценки в массиве
+    struct FTrackMeasurement
+    {
+        int32_t Index = 0;
+        FVec3 Position;
+        float Time = 0.0f;
+    };
+
+    // Обновить оценку по обнаружению положения в момент Time
+    void UpdateTrackEstimate(const FTrackFilterParams& Params, FTrackEstimate& Estimate, const FVec3& Position, float Time);
+
+    // Пакетное обновление без выделения памяти; обнаружения одной цели применяются в порядке массива
+    void UpdateTrackEstimates(const FTrackFilterParams& Params, FTrackEstimate* Estimates,
+                              const FTrackMeasurement* Measurements, int32_t NumMeasurements);
+
+    // Положение цели через Dt после последнего обнаружения с учетом ускорения
+    FVec3 ExtrapolateTrack(const FTrackEstimate& Estimate, float Dt);
+
+    // Слияние оценок одной цели от нескольких радаров. Оценки обновлялись в разные моменты, поэтому
+    // каждая сначала экстраполируется к общему моменту Time, затем положения и скорости усредняются
+    // с весом 1 / (1 + возраст оценки): свежие обнаружения весят больше.
+    // Скорость усредняется отдельно и только по оценкам из двух и более обнаружений:
+    // у трека с одним обнаружением скорость нулевая, а не оцененная.
+    struct FTrackFusion
+    {
+        FVec3 PositionSum;
+        FVec3 VelocitySum;
+        float WeightSum = 0.0f;
+        float VelocityWeightSum = 0.0f;
+
+        void Add(const FTrackEstimate& Estimate, float Time);
+        FVec3 GetPosition() const;
+        FVec3 GetVelocity() const;
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Sim/MelSimMissile.h"
+
+namespace MelSim
+{
+    // Участок прогнозируемой траектории, время отсчитывается от начала участка:
+    // P(t) = Start + Velocity t + Turn (I(TurnStart + t TurnRate) - I(TurnStart)), I(x) = x^3 - x^4 / 2.
+    // I - интеграл SmoothStep: так на участке перехода интегрируется поворот скорости от вертикали к цели.
+    // У прямых участков Turn нулевой.
+    struct FTrajectorySegment
+    {
+        FVec3 Start;
+        FVec3 Velocity;
+        FVec3 Turn;
+        float TurnStart = 0.0f;
+        float TurnRate = 0.0f;
+        float StartTime = 0.0f;  // Абсолютное время начала участка
+        float Duration = 0.0f;
+        EMissilePhase Phase = EMissilePhase::Ascending;
+    };
+
+    // Кусочно-аналитическая траектория ракеты от текущего положения до точки цели:
+    // подъем до TargetHeight, переход за TransitionTime, горизонтальный участок, снижение.
+    // Строится по фазе и параметрам полета один раз на фазу; запросы - O(1).
+    struct FMissileTrajectory
+    {
+        static constexpr int32_t MaxSegments = 4;
+
+        FTrajectorySegment Segments[MaxSegments];
+        int32_t NumSegments = 0;
+
+        // Фаза, из которой построен прогноз: при смене фазы траектория перестраивается
+        EMissilePhase Phase = EMissilePhase::Ascending;
+
+        float ImpactTime = 0.0f;  // Абсолютное время падения
+        FVec3 ImpactPoint;
+
+        bool IsValid() const { return NumSegments > 0; }
+    };
+
+    // Построить траекторию из состояния ракеты в момент Now
+    FMissileTrajectory BuildMissileTrajectory(const FMissileState& State, const FMissileParams& Params, float Now);
+
+    // Положение ракеты в момент Time (после падения - точка падения)
+    FVec3 EvaluateTrajectory(const FMissileTrajectory& Trajectory, float Time);
+
+    inline float GetTimeToImpact(const FMissileTrajectory& Trajectory, float Now)
+    {
+        const float TimeToImpact = Trajectory.ImpactTime - Now;
+        return TimeToImpact > 0.0f ? TimeToImpact : 0.0f;
+    }
+}
@@ -0,0 +1,281 @@
+// Проверки ядра симуляции MelSim без движка: собираются отдельной целью (см. CMakeLists.txt рядом),
+// потому что модуль Mel компилирует все .cpp своего каталога.
+
+#include "Sim/MelSimTrackFilter.h"
+#include "Sim/MelSimMissileBatch.h"
+#include "Sim/MelSimProjectileBatch.h"
+#include "Sim/MelSimThreatHeap.h"
+#include "Sim/MelSimTrajectory.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace MelSim;
+
+namespace
+{
+    int NumFailures = 0;
+
+    void Check(bool bCondition, const char* Expression, const char* File, int Line)
+    {
+        if (!bCondition)
+        {
+            std::printf("%s:%d: FAILED: %s\n", File, Line, Expression);
+            ++NumFailures;
+        }
+    }
+
+    #define MELSIM_CHECK(Expression) Check((Expression), #Expression, __FILE__, __LINE__)
+
+    bool NearlyEqual(float A, float B, float Tolerance)
+    {
+        return std::fabs(A - B) <= Tolerance;
+    }
+
+    bool SameBits(float A, float B)
+    {
+        return std::memcmp(&A, &B, sizeof(float)) == 0;
+    }
+
+    bool SameBits(const FVec3& A, const FVec3& B)
+    {
+        return SameBits(A.X, B.X) && SameBits(A.Y, B.Y) && SameBits(A.Z, B.Z);
+    }
+
+    // Коэффициенты альфа-бета-гамма по формулам критического затухания и сходимость на равномерном движении
+    void TestTrackFilterGains()
+    {
+        for (float Theta : { 0.0f, 0.3f, 0.6f, 0.9f })
+        {
+            const FTrackFilterParams Params = MakeTrackFilterParams(Theta);
+            MELSIM_CHECK(NearlyEqual(Params.Alpha, 1.0f - Theta * Theta * Theta, 1e-6f));
+            MELSIM_CHECK(NearlyEqual(Params.Beta, 1.5f * (1.0f - Theta) * (1.0f - Theta) * (1.0f + Theta), 1e-6f));
+            MELSIM_CHECK(NearlyEqual(Params.Gamma, 0.5f * (1.0f - Theta) * (1.0f - Theta) * (1.0f - Theta), 1e-6f));
+        }
+
+        // Значения по умолчанию - то же затухание θ = 0.3
+        const FTrackFilterParams Defaults;
+        const FTrackFilterParams Made = MakeTrackFilterParams(0.3f);
+        MELSIM_CHECK(NearlyEqual(Defaults.Alpha, Made.Alpha, 1e-4f));
+        MELSIM_CHECK(NearlyEqual(Defaults.Beta, Made.Beta, 1e-4f));
+        MELSIM_CHECK(NearlyEqual(Defaults.Gamma, Made.Gamma, 1e-4f));
+
+        const FVec3 Start(1000.0f, -2000.0f, 5000.0f);
+        const FVec3 Velocity(300.0f, 150.0f, -200.0f);
+        FTrackEstimate Estimate;
+        for (int32_t Step = 0; Step < 40; ++Step)
+        {
+            const float Time = static_cast<float>(Step) * 0.1f;
+            UpdateTrackEstimate(Made, Estimate, Start + Velocity * Time, Time);
+        }
+        MELSIM_CHECK(Estimate.NumUpdates == 40);
+        MELSIM_CHECK(FVec3::Dist(Estimate.Velocity, Velocity) < 1.0f);
+        MELSIM_CHECK(FVec3::Dist(ExtrapolateTrack(Estimate, 1.0f), Start + Velocity * 4.9f) < 5.0f);
+    }
+
+    // Векторный шаг пакета (по 4 ракеты) и хвост пакета побитово совпадают со StepMissile
+    void TestMissileBatchMatchesScalar()
+    {
+        FMissileParams Params;
+        std::vector<FMissileState> Reference;
+        std::vector<int32_t> Ids;
+        FMissileBatch Batch;
+
+        for (int32_t i = 0; i < 7; ++i)
+        {
+            const float Angle = static_cast<float>(i) * 0.9f;
+            const FVec3 Launch(std::cos(Angle) * (15000.0f + 2500.0f * static_cast<float>(i)),
+                               std::sin(Angle) * (15000.0f + 2500.0f * static_cast<float>(i)), 100.0f);
+            const FMissileState State = MakeMissile(Launch, FVec3(0.0f, 0.0f, 0.0f), Params);
+            Reference.push_back(State);
+            Ids.push_back(Batch.Add(State, Params));
+        }
+
+        const float Dt = 1.0f / 60.0f;
+        bool bSame = true;
+        bool bPhasesSame = true;
+        for (int32_t Step = 0; Step < 2400; ++Step)
+        {
+            Batch.Step(Dt);
+            for (size_t i = 0; i < Reference.size(); ++i)
+            {
+                StepMissile(Reference[i], Params, Dt);
+                const int32_t Index = Batch.GetIndex(Ids[i]);
+                bSame = bSame && SameBits(Batch.GetPosition(Index), Reference[i].Position) &&
+                        SameBits(Batch.GetVelocity(Index), Reference[i].Velocity);
+                bPhasesSame = bPhasesSame && Batch.GetPhase(Index) == Reference[i].Phase;
+            }
+        }
+        MELSIM_CHECK(bSame);
+        MELSIM_CHECK(bPhasesSame);
+
+        // За 40 секунд все ракеты прошли фазы до снижения
+        for (const FMissileState& State : Reference)
+        {
+            MELSIM_CHECK(State.Phase == EMissilePhase::Descent);
+        }
+    }
+
+    // Стабильные идентификаторы пакетов: освобожденный идентификатор переиспользуется,
+    // остальные сохраняют свои ракеты при перестановке плотных индексов
+    void TestStableIdReuse()
+    {
+        FMissileParams Params;
+        FMissileBatch Batch;
+        std::vector<int32_t> Ids;
+        for (int32_t i = 0; i < 5; ++i)
+        {
+            Ids.push_back(Batch.Add(MakeMissile(FVec3(1000.0f * static_cast<float>(i), 0.0f, 0.0f), FVec3(), Params), Params));
+        }
+
+        Batch.Remove(Ids[1]);
+        MELSIM_CHECK(!Batch.Contains(Ids[1]));
+        MELSIM_CHECK(Batch.GetIndex(Ids[1]) == -1);
+        MELSIM_CHECK(Batch.Num() == 4);
+        for (int32_t i : { 0, 2, 3, 4 })
+        {
+            const int32_t Index = Batch.GetIndex(Ids[i]);
+            MELSIM_CHECK(Batch.GetId(Index) == Ids[i]);
+            MELSIM_CHECK(Batch.GetPosition(Index).X == 1000.0f * static_cast<float>(i));
+        }
+
+        // Повторное удаление не трогает пакет
+        Batch.Remove(Ids[1]);
+        MELSIM_CHECK(Batch.Num() == 4);
+
+        const int32_t Reused = Batch.Add(MakeMissile(FVec3(0.0f, 7000.0f, 0.0f), FVec3(), Params), Params);
+        MELSIM_CHECK(Reused == Ids[1]);
+        MELSIM_CHECK(Batch.GetPosition(Batch.GetIndex(Reused)).Y == 7000.0f);
+        MELSIM_CHECK(Batch.GetPosition(Batch.GetIndex(Ids[4])).X == 4000.0f);
+
+        FProjectileBatch Projectiles;
+        FProjectileState Projectile;
+        const int32_t First = Projectiles.Add(Projectile);
+        const int32_t Second = Projectiles.Add(Projectile);
+        Projectiles.Remove(First);
+        MELSIM_CHECK(!Projectiles.Contains(First));
+        MELSIM_CHECK(Projectiles.GetId(Projectiles.GetIndex(Second)) == Second);
+        MELSIM_CHECK(Projectiles.Add(Projectile) == First);
+    }
+
+    // Куча угроз: порядок обхода, обновление и удаление ключей, вложенный обход
+    void TestThreatHeap()
+    {
+        FThreatHeap Heap;
+        const float Threats[] = { 0.3f, 0.9f, 0.1f, 0.7f, 0.5f, 0.8f, 0.2f, 0.6f, 0.4f };
+        const int32_t NumKeys = static_cast<int32_t>(sizeof(Threats) / sizeof(Threats[0]));
+        for (int32_t Key = 0; Key < NumKeys; ++Key)
+        {
+            Heap.Set(Key, Threats[Key]);
+        }
+        MELSIM_CHECK(Heap.Num() == NumKeys);
+        MELSIM_CHECK(Heap.Top() == 1);
+
+        std::vector<int32_t> Visited;
+        Heap.VisitDescending([&Visited](int32_t Key)
+        {
+            Visited.push_back(Key);
+            return false;
+        });
+        const std::vector<int32_t> Expected = { 1, 5, 3, 7, 4, 8, 0, 6, 2 };
+        MELSIM_CHECK(Visited == Expected);
+
+        // Остановка обхода и GetTop дают тот же префикс
+        std::vector<int32_t> Top;
+        Heap.GetTop(3, Top);
+        MELSIM_CHECK(Top == std::vector<int32_t>(Expected.begin(), Expected.begin() + 3));
+
+        int32_t NumVisited = 0;
+        Heap.VisitDescending([&NumVisited](int32_t)
+        {
+            return ++NumVisited == 2;
+        });
+        MELSIM_CHECK(NumVisited == 2);
+
+        // Обновление угрозы и удаление
+        Heap.Set(2, 0.95f);
+        Heap.Remove(1);
+        MELSIM_CHECK(!Heap.Contains(1));
+        MELSIM_CHECK(Heap.Top() == 2);
+        MELSIM_CHECK(Heap.GetThreat(2) == 0.95f);
+
+        // Вложенный обход со своим буфером не сбивает внешний
+        std::vector<int32_t> Outer;
+        int32_t NumPairs = 0;
+        Heap.VisitDescending([&](int32_t Key)
+        {
+            Outer.push_back(Key);
+            Heap.VisitDescending([&](int32_t)
+            {
+                ++NumPairs;
+                return false;
+            });
+            return false;
+        });
+        MELSIM_CHECK(static_cast<int32_t>(Outer.size()) == Heap.Num());
+        MELSIM_CHECK(NumPairs == Heap.Num() * Heap.Num());
+        for (size_t i = 1; i < Outer.size(); ++i)
+        {
+            MELSIM_CHECK(Heap.GetThreat(Outer[i - 1]) >= Heap.GetThreat(Outer[i]));
+        }
+
+        Heap.Reset();
+        MELSIM_CHECK(Heap.IsEmpty());
+        MELSIM_CHECK(Heap.Top() == -1);
+    }
+
+    // Прогноз траектории совпадает с пошаговым полетом: положение на каждом шаге и время падения
+    void TestTrajectoryPrediction()
+    {
+        const FMissileParams Params;
+        const FVec3 Launches[] = { FVec3(30000.0f, 1000.0f, 100.0f), FVec3(-5000.0f, 20000.0f, 100.0f), FVec3(3000.0f, -3000.0f, 100.0f) };
+        const float Dt = 1.0f / 60.0f;
+
+        for (const FVec3& Launch : Launches)
+        {
+            FMissileState State = MakeMissile(Launch, FVec3(0.0f, 0.0f, 0.0f), Params);
+            const FMissileTrajectory AtLaunch = BuildMissileTrajectory(State, Params, 0.0f);
+            MELSIM_CHECK(AtLaunch.IsValid());
+
+            // Прогноз перестраивается при смене фазы, как в подсистеме движения
+            FMissileTrajectory Trajectory = AtLaunch;
+            float Time = 0.0f;
+            float MaxError = 0.0f;
+            while (!HasReachedTarget(State, Params) && Time < 200.0f)
+            {
+                if (StepMissile(State, Params, Dt))
+                {
+                    Trajectory = BuildMissileTrajectory(State, Params, Time + Dt);
+                }
+                Time += Dt;
+                MaxError = std::max(MaxError, FVec3::Dist(EvaluateTrajectory(Trajectory, Time), State.Position));
+            }
+
+            MELSIM_CHECK(HasReachedTarget(State, Params));
+            MELSIM_CHECK(MaxError < 50.0f);
+            MELSIM_CHECK(NearlyEqual(AtLaunch.ImpactTime, Time, 0.1f));
+            MELSIM_CHECK(NearlyEqual(Trajectory.ImpactTime, Time, 0.1f));
+            MELSIM_CHECK(FVec3::Dist(Trajectory.ImpactPoint, State.Position) < 150.0f);
+            MELSIM_CHECK(GetTimeToImpact(Trajectory, Trajectory.ImpactTime + 1.0f) == 0.0f);
+        }
+    }
+}
+
+int main()
+{
+    TestTrackFilterGains();
+    TestMissileBatchMatchesScalar();
+    TestStableIdReuse();
+    TestThreatHeap();
+    TestTrajectoryPrediction();
+
+    if (NumFailures > 0)
+    {
+        std::printf("MelSim tests: %d failed\n", NumFailures);
+        return 1;
+    }
+    std::printf("MelSim tests: OK\n");
+    return 0;
+}